@@ -19,104 +19,47 @@ ASDTAIController::ASDTAIController(const FObjectInitializer& ObjectInitializer)
            
 }
 
-void ASDTAIController::GoToBestTarget(float deltaTime)
+FSDTAgentStateTable ASDTAIController::GetStateTable() const
 {
-    //Move to target depending on current behavior
-    APawn* pawn = GetPawn();
-
-    UPathFollowingComponent* path = GetPathFollowingComponent();
-    if (path == nullptr)
-    {
-        return;
-    }
-
-    switch (m_PedestrianState)
+    // Action run in each state and state entered once its move succeeds
+    static const FSDTAgentStateRow rows[] =
     {
-        case PedestrianState::SPAWNED:
-        {
-            FString tag("WaitPoint_Bridge_");
-            AActor* actor = FindActorWithTag(tag);
-            
-            if (actor != nullptr)
-            {
-                // TODO : Agents wants to move towards actor
-                m_ReachedTarget = false;  // TODO figure out correct way to set this to false
-                MoveToActor(actor);
-
-                m_PedestrianState = PedestrianState::GO_TO_BRIDGE;
-            }
-            break;
-        }
-        case PedestrianState::GO_TO_BRIDGE:
-        {
-            // Nothing to do
-            break;
-        }
-        case PedestrianState::WAIT_AT_BRIDGE:
-        {
-            // Check if bridge is down
-            FString tag("Bridge_");
-            AActor* actor = FindActorWithTag(tag);
-            ASDTBridge* bridge = Cast<ASDTBridge>(actor);
-            
-            // Once the bridge is down, we go through
-            if (bridge != nullptr && bridge->GetState() == EBridgeState::BRIDGE_DOWN)
-            {
-                m_PedestrianState = PedestrianState::GO_TO_DESPAWN;
-            }
-
-            break;
-        }
-        case PedestrianState::GO_TO_DESPAWN:
-        {
-            FString tag("Despawn_");
-            AActor* actor = FindActorWithTag(tag);
-            
-            if (actor != nullptr)
-            {
-                // TODO : Agents wants to move towards actor
-                m_ReachedTarget = false;
-                MoveToActor(actor);
-            }
-            
-            break;
-        }
-        case PedestrianState::DESPAWN:
-        {
-            UnPossess();
-            Destroy();
-
-            pawn->Destroy();
-            break;
-        }
-    }
+        { &ASDTAIController::Spawned,       uint8(PedestrianState::SPAWNED) },
+        { &ASDTAIController::GoToBridge,    uint8(PedestrianState::WAIT_AT_BRIDGE) },
+        { &ASDTAIController::WaitAtBridge,  uint8(PedestrianState::WAIT_AT_BRIDGE) },
+        { &ASDTAIController::GoToDespawn,   uint8(PedestrianState::DESPAWN) },
+        { &ASDTBaseAIController::Despawn,   uint8(PedestrianState::DESPAWN) },
+    };
+    static_assert(UE_ARRAY_COUNT(rows) == static_cast<int32>(PedestrianState::DESPAWN) + 1, "One row per PedestrianState");
+
+    return { rows, UE_ARRAY_COUNT(rows) };
 }
 
-void ASDTAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
+uint8 ASDTAIController::Spawned(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
 {
-    Super::OnMoveCompleted(RequestID, Result);
+    return uint8(PedestrianState::GO_TO_BRIDGE);
+}
 
-    m_ReachedTarget = true;
+uint8 ASDTAIController::GoToBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+    static_cast<ASDTAIController&>(controller).MoveToTaggedActor(states, agent, TEXT("WaitPoint_Bridge_"));
+    return uint8(PedestrianState::GO_TO_BRIDGE);
+}
 
-    // Safeguard
-    if (Result.Code == EPathFollowingResult::Aborted)
+uint8 ASDTAIController::WaitAtBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+    // Once the bridge is down, we go through. Until then the agent sleeps.
+    if (static_cast<ASDTAIController&>(controller).WaitForTaggedBridge(states, agent, TEXT("Bridge_"), true, EBridgeState::BRIDGE_DOWN))
     {
-        return;
+        return uint8(PedestrianState::GO_TO_DESPAWN);
     }
+    return uint8(PedestrianState::WAIT_AT_BRIDGE);
+}
 
-    switch (m_PedestrianState)
-    {
-        case PedestrianState::GO_TO_BRIDGE:
-        {
-            m_PedestrianState = PedestrianState::WAIT_AT_BRIDGE;
-            break;
-        }
-        case PedestrianState::GO_TO_DESPAWN:
-        {
-            m_PedestrianState = PedestrianState::DESPAWN;
-            break;
-        }
-    }
+uint8 ASDTAIController::GoToDespawn(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+    static_cast<ASDTAIController&>(controller).MoveToTaggedActor(states, agent, TEXT("Despawn_"));
+    return uint8(PedestrianState::GO_TO_DESPAWN);
 }
 
 void ASDTAIController::ShowNavigationPath()
@@ -161,7 +104,6 @@ void ASDTAIController::ShowNavigationPath()
 
 void ASDTAIController::AIStateInterrupted()
 {
+    // The aborted move is issued again after the agent state subsystem's retry delay
     StopMovement();
-
-    m_ReachedTarget = false;
 }
\ No newline at end of file
@@ -14,7 +14,7 @@ enum class ActionPriority
     COLLECTIBLE,
 };
 
-enum class PedestrianState
+enum class PedestrianState : uint8
 {
     SPAWNED,
     GO_TO_BRIDGE,
@@ -35,13 +35,16 @@ public:
     ASDTAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 public:
-    virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
     void AIStateInterrupted();
 
 
 private:
-    virtual void GoToBestTarget(float deltaTime) override;
+    virtual FSDTAgentStateTable GetStateTable() const override;
     virtual void ShowNavigationPath() override;
 
-    PedestrianState m_PedestrianState{ PedestrianState::SPAWNED };
+    // State actions, see GetStateTable
+    static uint8 Spawned(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 GoToBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 WaitAtBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 GoToDespawn(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
 };
@@ -3,6 +3,10 @@
 
 #include "SDTAISpawner.h"
 #include "SDTBaseAIController.h"
+#include "SDTActorPoolSubsystem.h"
+#include "SDTSpawnSchedulerSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/AssetManager.h"
 
 // Sets default values
 ASDTAISpawner::ASDTAISpawner()
@@ -18,6 +22,19 @@ ASDTAISpawner::ASDTAISpawner()
 void ASDTAISpawner::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Preload and the first spawn are spread over the next frames along with the other spawners
+	if (USDTSpawnSchedulerSubsystem* scheduler = GetWorld()->GetSubsystem<USDTSpawnSchedulerSubsystem>())
+	{
+		scheduler->RequestPreload(m_AIClassToSpawn, m_PoolPrewarmCount, GetActorTransform());
+		scheduler->RequestSpawn(this);
+		return;
+	}
+
+	if (USDTActorPoolSubsystem* pool = GetWorld()->GetSubsystem<USDTActorPoolSubsystem>())
+	{
+		pool->Prewarm(m_AIClassToSpawn.LoadSynchronous(), m_PoolPrewarmCount, GetActorTransform());
+	}
 	
 	Spawn();
 }
@@ -31,22 +48,51 @@ void ASDTAISpawner::Tick(float DeltaTime)
 	if (m_CurrentCooldown >= m_CooldownToSpawn)
 	{
 		m_CurrentCooldown = 0.f;
-		Spawn();
+
+		if (USDTSpawnSchedulerSubsystem* scheduler = GetWorld()->GetSubsystem<USDTSpawnSchedulerSubsystem>())
+		{
+			scheduler->RequestSpawn(this);
+		}
+		else
+		{
+			Spawn();
+		}
 	}
 }
 
+bool ASDTAISpawner::IsReadyToSpawn() const
+{
+	// A failed load counts as ready, Spawn then simply does nothing
+	return m_AIClassToSpawn.IsNull() || m_AIClassToSpawn.IsValid() ||
+		UAssetManager::GetStreamableManager().IsAsyncLoadComplete(m_AIClassToSpawn.ToSoftObjectPath());
+}
+
 void ASDTAISpawner::Spawn()
 {
-	if (m_AIClassToSpawn != nullptr)
+	// Already resident when spawning through the scheduler, only the fallback path loads here
+	UClass* aiClass = m_AIClassToSpawn.LoadSynchronous();
+	if (aiClass != nullptr)
 	{
-		FActorSpawnParameters parameters;
-		parameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		APawn* npc = nullptr;
+		if (USDTActorPoolSubsystem* pool = GetWorld()->GetSubsystem<USDTActorPoolSubsystem>())
+		{
+			// The pool returns the pawn already possessed by its controller
+			npc = pool->Acquire<APawn>(aiClass, GetActorTransform());
+		}
+		else
+		{
+			FActorSpawnParameters parameters;
+			parameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+			npc = GetWorld()->SpawnActor<APawn>(aiClass, GetActorLocation(), GetActorRotation(), parameters);
+			if (npc)
+			{
+				npc->SpawnDefaultController();
+			}
+		}
 
-		APawn* npc = GetWorld()->SpawnActor<APawn>(m_AIClassToSpawn, GetActorLocation(), GetActorRotation(), parameters);
 		if (npc)
 		{
-			npc->SpawnDefaultController();
-
 			ASDTBaseAIController* controller = Cast<ASDTBaseAIController>(npc->GetController());
 			if (controller != nullptr)
 			{
@@ -21,8 +21,12 @@ public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	// Spawns immediately. Tick goes through USDTSpawnSchedulerSubsystem instead.
 	void Spawn();
 
+	// False while the AI class is still being loaded
+	bool IsReadyToSpawn() const;
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawner")
 	float m_CooldownToSpawn;
@@ -30,9 +34,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawner")
 	float m_CurrentCooldown;
 
+	// Soft reference: loaded asynchronously by the spawn scheduler instead of with the level
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawner")
-	UClass* m_AIClassToSpawn;
+	TSoftClassPtr<APawn> m_AIClassToSpawn;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawner")
 	FString m_TagToLookFor;
+
+	// Number of pawn/controller pairs created up front in the actor pool
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawner")
+	int32 m_PoolPrewarmCount = 2;
 };
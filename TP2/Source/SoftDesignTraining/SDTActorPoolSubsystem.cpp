@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTActorPoolSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "AIController.h"
+#include "GameFramework/Pawn.h"
+
+void USDTActorPoolSubsystem::Deinitialize()
+{
+	m_FreeActors.Empty();
+	m_SuspendedActors.Empty();
+	m_SuspendedComponents.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USDTActorPoolSubsystem::Prewarm(TSubclassOf<AActor> Class, int32 Count, const FTransform& Transform)
+{
+	if (Class == nullptr)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (AActor* actor = SpawnPooledActor(Class, Transform))
+		{
+			Release(actor);
+		}
+	}
+}
+
+AActor* USDTActorPoolSubsystem::Acquire(TSubclassOf<AActor> Class, const FTransform& Transform)
+{
+	if (Class == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (FSDTActorPoolList* pool = m_FreeActors.Find(Class.Get()))
+	{
+		while (pool->Actors.Num() > 0)
+		{
+			AActor* actor = pool->Actors.Pop();
+			if (IsValid(actor))
+			{
+				actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+				ActivateActor(actor);
+				return actor;
+			}
+		}
+	}
+
+	return SpawnPooledActor(Class, Transform);
+}
+
+void USDTActorPoolSubsystem::Release(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	DeactivateActor(Actor);
+	m_FreeActors.FindOrAdd(Actor->GetClass()).Actors.Add(Actor);
+}
+
+int32 USDTActorPoolSubsystem::GetNumFree(TSubclassOf<AActor> Class) const
+{
+	const FSDTActorPoolList* pool = m_FreeActors.Find(Class.Get());
+	return pool ? pool->Actors.Num() : 0;
+}
+
+AActor* USDTActorPoolSubsystem::SpawnPooledActor(UClass* Class, const FTransform& Transform)
+{
+	FActorSpawnParameters parameters;
+	parameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AActor* actor = GetWorld()->SpawnActor<AActor>(Class, Transform, parameters);
+
+	// Pawn and controller are pooled as a pair
+	if (APawn* pawn = Cast<APawn>(actor))
+	{
+		if (pawn->GetController() == nullptr)
+		{
+			pawn->SpawnDefaultController();
+		}
+	}
+
+	return actor;
+}
+
+void USDTActorPoolSubsystem::DeactivateActor(AActor* Actor)
+{
+	TArray<AActor*> actors{ Actor };
+	if (APawn* pawn = Cast<APawn>(Actor))
+	{
+		if (AController* controller = pawn->GetController())
+		{
+			if (AAIController* aiController = Cast<AAIController>(controller))
+			{
+				aiController->StopMovement();
+			}
+			actors.Add(controller);
+		}
+	}
+
+	for (AActor* actor : actors)
+	{
+		if (ISDTPoolable* poolable = Cast<ISDTPoolable>(actor))
+		{
+			poolable->OnReleasedToPool();
+		}
+
+		TArray<TWeakObjectPtr<UActorComponent>>& suspended = m_SuspendedComponents.FindOrAdd(actor);
+		suspended.Reset();
+
+		actor->ForEachComponent(false, [&suspended](UActorComponent* component)
+		{
+			if (component->IsComponentTickEnabled())
+			{
+				suspended.Add(component);
+				component->SetComponentTickEnabled(false);
+			}
+		});
+
+		if (actor->IsActorTickEnabled())
+		{
+			m_SuspendedActors.Add(actor);
+			actor->SetActorTickEnabled(false);
+		}
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+}
+
+void USDTActorPoolSubsystem::ActivateActor(AActor* Actor)
+{
+	Actor->SetActorHiddenInGame(false);
+	Actor->SetActorEnableCollision(true);
+
+	TArray<AActor*> actors{ Actor };
+	if (APawn* pawn = Cast<APawn>(Actor))
+	{
+		if (AController* controller = pawn->GetController())
+		{
+			actors.Add(controller);
+		}
+	}
+
+	for (AActor* actor : actors)
+	{
+		if (m_SuspendedActors.Remove(actor) > 0)
+		{
+			actor->SetActorTickEnabled(true);
+		}
+
+		if (TArray<TWeakObjectPtr<UActorComponent>>* suspended = m_SuspendedComponents.Find(actor))
+		{
+			for (const TWeakObjectPtr<UActorComponent>& component : *suspended)
+			{
+				if (component.IsValid())
+				{
+					component->SetComponentTickEnabled(true);
+				}
+			}
+			m_SuspendedComponents.Remove(actor);
+		}
+
+		if (ISDTPoolable* poolable = Cast<ISDTPoolable>(actor))
+		{
+			poolable->OnAcquiredFromPool();
+		}
+	}
+}
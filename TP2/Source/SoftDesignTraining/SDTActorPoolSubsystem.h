@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/Interface.h"
+#include "SDTActorPoolSubsystem.generated.h"
+
+UINTERFACE(MinimalAPI)
+class USDTPoolable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by pooled actors (and their controllers) that need to reset their state.
+ */
+class SOFTDESIGNTRAINING_API ISDTPoolable
+{
+	GENERATED_BODY()
+
+public:
+	// Called after the actor was reactivated and placed at its new transform
+	virtual void OnAcquiredFromPool() {}
+
+	// Called before the actor is deactivated and returned to the pool
+	virtual void OnReleasedToPool() {}
+};
+
+USTRUCT()
+struct FSDTActorPoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> Actors;
+};
+
+/**
+ * World actor pool. Released actors are hidden, lose collision and stop ticking instead of being
+ * destroyed, so steady-state spawning no longer allocates nor feeds the garbage collector.
+ * Pawns are pooled together with their AI controller: the controller stays possessed while pooled.
+ */
+UCLASS()
+class SOFTDESIGNTRAINING_API USDTActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Spawns Count inactive actors of Class (with their default controller for pawns)
+	void Prewarm(TSubclassOf<AActor> Class, int32 Count, const FTransform& Transform);
+
+	// Returns a pooled actor, or spawns one if the pool is empty
+	AActor* Acquire(TSubclassOf<AActor> Class, const FTransform& Transform);
+
+	template <typename T>
+	T* Acquire(TSubclassOf<AActor> Class, const FTransform& Transform) { return Cast<T>(Acquire(Class, Transform)); }
+
+	// Deactivates the actor (and its controller for a pawn) and returns it to its class pool
+	void Release(AActor* Actor);
+
+	int32 GetNumFree(TSubclassOf<AActor> Class) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	AActor* SpawnPooledActor(UClass* Class, const FTransform& Transform);
+	void DeactivateActor(AActor* Actor);
+	void ActivateActor(AActor* Actor);
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FSDTActorPoolList> m_FreeActors;
+
+	// Actors and components that were ticking when released, restored on acquire
+	TSet<TWeakObjectPtr<AActor>> m_SuspendedActors;
+	TMap<TWeakObjectPtr<AActor>, TArray<TWeakObjectPtr<UActorComponent>>> m_SuspendedComponents;
+};
@@ -0,0 +1,337 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTAgentStateSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "SDTBaseAIController.h"
+
+void USDTAgentStateSubsystem::Deinitialize()
+{
+	for (const TPair<TWeakObjectPtr<ASDTBridge>, FBridgeWaiters>& bridgeWaiters : m_BridgeWaiters)
+	{
+		if (ASDTBridge* bridge = bridgeWaiters.Key.Get())
+		{
+			bridge->OnStateChanged().Remove(bridgeWaiters.Value.Handle);
+		}
+	}
+	m_BridgeWaiters.Empty();
+
+	m_Controllers.Empty();
+	m_Tables.Empty();
+	m_States.Empty();
+	m_Targets.Empty();
+	m_RetryTimes.Empty();
+	m_FreeAgents.Empty();
+	m_ActivePositions.Empty();
+	m_ActiveAgents.Empty();
+	m_VisitedAgents.Empty();
+	m_RetryPositions.Empty();
+	m_RetryAgents.Empty();
+	m_MovingPositions.Empty();
+	m_MovingAgents.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTAgentStateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTAgentStateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTAgentStateSubsystem, STATGROUP_Tickables);
+}
+
+int32 USDTAgentStateSubsystem::RegisterAgent(ASDTBaseAIController* Controller, const FSDTAgentStateTable& Table)
+{
+	int32 agent;
+	if (m_FreeAgents.Num() > 0)
+	{
+		agent = m_FreeAgents.Pop();
+		m_Controllers[agent] = Controller;
+		m_Tables[agent] = Table;
+	}
+	else
+	{
+		agent = m_Controllers.Add(Controller);
+		m_Tables.Add(Table);
+		m_States.Add(0);
+		m_Targets.AddDefaulted();
+		m_RetryTimes.Add(0.0);
+		m_ActivePositions.Add(INDEX_NONE);
+		m_RetryPositions.Add(INDEX_NONE);
+		m_MovingPositions.Add(INDEX_NONE);
+	}
+
+	ResetAgent(agent);
+	return agent;
+}
+
+void USDTAgentStateSubsystem::UnregisterAgent(int32 Agent)
+{
+	if (!m_Controllers.IsValidIndex(Agent))
+	{
+		return;
+	}
+
+	SleepAgent(Agent);
+	SetAgentMoving(Agent, false);
+	m_Controllers[Agent].Reset();
+	m_Tables[Agent] = FSDTAgentStateTable();
+	m_Targets[Agent].Reset();
+	m_FreeAgents.Add(Agent);
+}
+
+void USDTAgentStateSubsystem::ResetAgent(int32 Agent)
+{
+	if (m_Targets.IsValidIndex(Agent))
+	{
+		m_Targets[Agent].Reset();
+		SetState(Agent, 0);
+	}
+}
+
+void USDTAgentStateSubsystem::AddToList(TArray<int32>& List, TArray<int32>& Positions, int32 Agent)
+{
+	if (Positions.IsValidIndex(Agent) && Positions[Agent] == INDEX_NONE)
+	{
+		Positions[Agent] = List.Add(Agent);
+	}
+}
+
+void USDTAgentStateSubsystem::RemoveFromList(TArray<int32>& List, TArray<int32>& Positions, int32 Agent)
+{
+	if (!Positions.IsValidIndex(Agent) || Positions[Agent] == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 position = Positions[Agent];
+	List.RemoveAtSwap(position);
+	if (List.IsValidIndex(position))
+	{
+		Positions[List[position]] = position;
+	}
+	Positions[Agent] = INDEX_NONE;
+}
+
+const FSDTAgentStateRow* USDTAgentStateSubsystem::GetRow(int32 Agent) const
+{
+	if (!m_States.IsValidIndex(Agent))
+	{
+		return nullptr;
+	}
+
+	const FSDTAgentStateTable& table = m_Tables[Agent];
+	const int32 state = m_States[Agent];
+	return state < table.NumRows ? &table.Rows[state] : nullptr;
+}
+
+void USDTAgentStateSubsystem::WakeAgent(int32 Agent)
+{
+	AddToList(m_ActiveAgents, m_ActivePositions, Agent);
+}
+
+void USDTAgentStateSubsystem::SleepAgent(int32 Agent)
+{
+	RemoveFromList(m_ActiveAgents, m_ActivePositions, Agent);
+	ClearWaits(Agent);
+}
+
+void USDTAgentStateSubsystem::ClearWaits(int32 Agent)
+{
+	RemoveFromList(m_RetryAgents, m_RetryPositions, Agent);
+
+	for (TPair<TWeakObjectPtr<ASDTBridge>, FBridgeWaiters>& bridgeWaiters : m_BridgeWaiters)
+	{
+		bridgeWaiters.Value.Waiters.RemoveAllSwap([Agent](const FBridgeWaiter& waiter) { return waiter.Agent == Agent; });
+	}
+}
+
+uint8 USDTAgentStateSubsystem::GetState(int32 Agent) const
+{
+	return m_States.IsValidIndex(Agent) ? m_States[Agent] : 0;
+}
+
+void USDTAgentStateSubsystem::SetState(int32 Agent, uint8 State)
+{
+	if (!m_States.IsValidIndex(Agent))
+	{
+		return;
+	}
+
+	// Whatever the previous state was waiting for no longer matters
+	ClearWaits(Agent);
+	m_States[Agent] = State;
+
+	const FSDTAgentStateRow* row = GetRow(Agent);
+	if (row != nullptr && row->Update != nullptr)
+	{
+		WakeAgent(Agent);
+	}
+	else
+	{
+		RemoveFromList(m_ActiveAgents, m_ActivePositions, Agent);
+	}
+}
+
+AActor* USDTAgentStateSubsystem::GetTarget(int32 Agent) const
+{
+	return m_Targets.IsValidIndex(Agent) ? m_Targets[Agent].Get() : nullptr;
+}
+
+void USDTAgentStateSubsystem::SetTarget(int32 Agent, AActor* Target)
+{
+	if (m_Targets.IsValidIndex(Agent))
+	{
+		m_Targets[Agent] = Target;
+	}
+}
+
+void USDTAgentStateSubsystem::RetryLater(int32 Agent)
+{
+	if (m_RetryTimes.IsValidIndex(Agent))
+	{
+		m_RetryTimes[Agent] = GetWorld()->GetTimeSeconds() + RetryDelay;
+		AddToList(m_RetryAgents, m_RetryPositions, Agent);
+	}
+}
+
+bool USDTAgentStateSubsystem::WaitForBridgeState(int32 Agent, ASDTBridge* Bridge, EBridgeState State)
+{
+	SetTarget(Agent, Bridge);
+	if (Bridge->GetState() == State)
+	{
+		return true;
+	}
+
+	FBridgeWaiters& bridgeWaiters = m_BridgeWaiters.FindOrAdd(Bridge);
+	if (!bridgeWaiters.Handle.IsValid())
+	{
+		bridgeWaiters.Handle = Bridge->OnStateChanged().AddUObject(this, &USDTAgentStateSubsystem::OnBridgeStateChanged);
+	}
+
+	if (!bridgeWaiters.Waiters.ContainsByPredicate([Agent](const FBridgeWaiter& waiter) { return waiter.Agent == Agent; }))
+	{
+		bridgeWaiters.Waiters.Add({ Agent, State });
+	}
+	return false;
+}
+
+void USDTAgentStateSubsystem::OnBridgeStateChanged(ASDTBridge* Bridge, EBridgeState State)
+{
+	FBridgeWaiters* bridgeWaiters = m_BridgeWaiters.Find(Bridge);
+	if (bridgeWaiters == nullptr)
+	{
+		return;
+	}
+
+	TArray<FBridgeWaiter>& waiters = bridgeWaiters->Waiters;
+	for (int32 i = waiters.Num() - 1; i >= 0; --i)
+	{
+		if (waiters[i].State == State)
+		{
+			WakeAgent(waiters[i].Agent);
+			waiters.RemoveAtSwap(i);
+		}
+	}
+}
+
+void USDTAgentStateSubsystem::SetAgentMoving(int32 Agent, bool bMoving)
+{
+	if (bMoving)
+	{
+		AddToList(m_MovingAgents, m_MovingPositions, Agent);
+	}
+	else
+	{
+		RemoveFromList(m_MovingAgents, m_MovingPositions, Agent);
+	}
+}
+
+void USDTAgentStateSubsystem::OnMoveCompleted(int32 Agent, const FPathFollowingResult& Result)
+{
+	SetAgentMoving(Agent, false);
+
+	const FSDTAgentStateRow* row = GetRow(Agent);
+	if (row == nullptr || row->MoveCompletedState == m_States[Agent])
+	{
+		// The current state issued no move
+		return;
+	}
+
+	if (Result.IsSuccess())
+	{
+		SetState(Agent, row->MoveCompletedState);
+	}
+	else if (!Result.HasFlag(FPathFollowingResultFlags::NewRequest))
+	{
+		// Blocked or interrupted: the state issues its move again
+		RetryLater(Agent);
+	}
+}
+
+void USDTAgentStateSubsystem::Tick(float DeltaTime)
+{
+	// Iterated backwards, a removal swaps in an agent that was already checked
+	const double time = GetWorld()->GetTimeSeconds();
+	for (int32 i = m_RetryAgents.Num() - 1; i >= 0; --i)
+	{
+		const int32 agent = m_RetryAgents[i];
+		if (m_RetryTimes[agent] <= time)
+		{
+			RemoveFromList(m_RetryAgents, m_RetryPositions, agent);
+			WakeAgent(agent);
+		}
+	}
+
+	// Agents can wake or put each other to sleep while they update (bridge, operator, pool)
+	m_VisitedAgents = m_ActiveAgents;
+
+	for (const int32 agent : m_VisitedAgents)
+	{
+		if (m_ActivePositions[agent] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		ASDTBaseAIController* controller = m_Controllers[agent].Get();
+		const FSDTAgentStateRow* row = GetRow(agent);
+		if (controller == nullptr || row == nullptr || row->Update == nullptr)
+		{
+			RemoveFromList(m_ActiveAgents, m_ActivePositions, agent);
+			continue;
+		}
+
+		const uint8 state = m_States[agent];
+		const uint8 nextState = row->Update(*controller, *this, agent);
+
+		if (m_States[agent] != state)
+		{
+			// An event raised by the action already moved the agent on (operator assigned, move finished at once)
+			continue;
+		}
+
+		if (nextState == state)
+		{
+			// Waiting for an event or a retry, see the action
+			RemoveFromList(m_ActiveAgents, m_ActivePositions, agent);
+		}
+		else
+		{
+			SetState(agent, nextState);
+		}
+	}
+
+	if (!bDrawPaths)
+	{
+		return;
+	}
+
+	for (const int32 agent : m_MovingAgents)
+	{
+		if (ASDTBaseAIController* controller = m_Controllers[agent].Get())
+		{
+			controller->ShowNavigationPath();
+		}
+	}
+}
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "SDTBridge.h"
+#include "SDTAgentStateSubsystem.generated.h"
+
+class ASDTBaseAIController;
+class USDTAgentStateSubsystem;
+
+// Run by the agent state tick for the agent's current state. Returns the next state, or the current one
+// to wait in it: the agent then sleeps until an event (move completed, bridge, operator) or its retry timer.
+using FSDTAgentStateAction = uint8 (*)(ASDTBaseAIController& Controller, USDTAgentStateSubsystem& States, int32 Agent);
+
+struct FSDTAgentStateRow
+{
+	// nullptr for states that only wait for an event, they are never visited
+	FSDTAgentStateAction Update;
+	// State entered when the move issued in this state succeeds, the state itself if it issues no move
+	uint8 MoveCompletedState;
+};
+
+// One row per state, indexed by the state value
+struct FSDTAgentStateTable
+{
+	const FSDTAgentStateRow* Rows = nullptr;
+	int32 NumRows = 0;
+};
+
+/**
+ * Runs the pedestrian and boat state machines from one tick instead of one actor tick per controller.
+ * Each agent's state, target (waypoint, bridge or operator) and retry timer live in packed arrays indexed
+ * by a handle stored on the controller; transitions come from the controller's state table, the
+ * controllers only provide the per-state actions.
+ * Only agents on the active list are visited: an agent is dropped from it as soon as its state waits for
+ * something (move, bridge, operator, pool) and is put back by the event that ends the wait or by its
+ * retry timer. Idle and waiting agents cost nothing per frame. Path drawing only visits the moving list,
+ * filled when a move is issued and emptied when it completes.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTAgentStateSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	int32 RegisterAgent(ASDTBaseAIController* Controller, const FSDTAgentStateTable& Table);
+	void UnregisterAgent(int32 Agent);
+
+	// Back to state 0 with no target, as when the agent was spawned
+	void ResetAgent(int32 Agent);
+	// Drops the agent from every list until its next state change, used when it goes back to the pool
+	void SleepAgent(int32 Agent);
+
+	uint8 GetState(int32 Agent) const;
+	// The agent is visited from the next tick on if the new state has an action
+	void SetState(int32 Agent, uint8 State);
+
+	AActor* GetTarget(int32 Agent) const;
+	void SetTarget(int32 Agent, AActor* Target);
+
+	// Visits the agent again in its current state after RetryDelay, when its action could not complete
+	void RetryLater(int32 Agent);
+
+	// Returns true if the bridge is already in the given state, otherwise the agent is visited again once
+	// the bridge broadcasts that state
+	bool WaitForBridgeState(int32 Agent, ASDTBridge* Bridge, EBridgeState State);
+
+	// Agents with a move in progress, their paths are drawn when bDrawPaths is on
+	void SetAgentMoving(int32 Agent, bool bMoving);
+	// Success takes the transition of the state table, a failure retries the state
+	void OnMoveCompleted(int32 Agent, const FPathFollowingResult& Result);
+
+	int32 GetNumActiveAgents() const { return m_ActiveAgents.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Draws the path of moving agents every frame, as their own tick used to
+	UPROPERTY(Config)
+	bool bDrawPaths = true;
+
+	// Delay before a state whose target is missing or whose move failed is tried again
+	UPROPERTY(Config)
+	float RetryDelay = 0.5f;
+
+private:
+	struct FBridgeWaiter
+	{
+		int32 Agent;
+		EBridgeState State;
+	};
+
+	struct FBridgeWaiters
+	{
+		FDelegateHandle Handle;
+		TArray<FBridgeWaiter> Waiters;
+	};
+
+	// Packed list of agents with their position in it (INDEX_NONE when absent)
+	static void AddToList(TArray<int32>& List, TArray<int32>& Positions, int32 Agent);
+	static void RemoveFromList(TArray<int32>& List, TArray<int32>& Positions, int32 Agent);
+
+	// Row of the agent's current state, nullptr if its table has none
+	const FSDTAgentStateRow* GetRow(int32 Agent) const;
+
+	void WakeAgent(int32 Agent);
+	// Drops the retry timer and bridge waits of the agent
+	void ClearWaits(int32 Agent);
+	void OnBridgeStateChanged(ASDTBridge* Bridge, EBridgeState State);
+
+	TArray<TWeakObjectPtr<ASDTBaseAIController>> m_Controllers;
+	TArray<FSDTAgentStateTable> m_Tables;
+	TArray<uint8> m_States;
+	TArray<TWeakObjectPtr<AActor>> m_Targets;
+	// World time at which the agent is woken again, see RetryLater
+	TArray<double> m_RetryTimes;
+	TArray<int32> m_FreeAgents;
+
+	// Position in m_ActiveAgents, INDEX_NONE while asleep
+	TArray<int32> m_ActivePositions;
+	TArray<int32> m_ActiveAgents;
+	TArray<int32> m_VisitedAgents;
+
+	TArray<int32> m_RetryPositions;
+	TArray<int32> m_RetryAgents;
+
+	TArray<int32> m_MovingPositions;
+	TArray<int32> m_MovingAgents;
+
+	TMap<TWeakObjectPtr<ASDTBridge>, FBridgeWaiters> m_BridgeWaiters;
+};
@@ -3,26 +3,60 @@
 #include "SDTBaseAIController.h"
 #include "SoftDesignTraining.h"
 #include "SDTPathFollowingComponent.h"
+#include "SDTTagRegistrySubsystem.h"
+#include "SDTAgentStateSubsystem.h"
 
 ASDTBaseAIController::ASDTBaseAIController(const FObjectInitializer& ObjectInitializer)
     :Super(ObjectInitializer)
 {
-    PrimaryActorTick.bCanEverTick = true;
-    PrimaryActorTick.bStartWithTickEnabled = true;
-    m_ReachedTarget = true;
+    // The state machine is run by the agent state subsystem, only for agents with work to do
+    PrimaryActorTick.bCanEverTick = false;
 }
 
-void ASDTBaseAIController::Tick(float deltaTime)
+void ASDTBaseAIController::BeginPlay()
 {
-    Super::Tick(deltaTime);
+    Super::BeginPlay();
 
-    if (m_ReachedTarget)
+    if (USDTAgentStateSubsystem* agentStates = GetAgentStates())
     {
-        GoToBestTarget(deltaTime);
+        m_AgentHandle = agentStates->RegisterAgent(this, GetStateTable());
     }
-    else
+}
+
+void ASDTBaseAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USDTAgentStateSubsystem* agentStates = GetAgentStates())
+    {
+        agentStates->UnregisterAgent(m_AgentHandle);
+    }
+    m_AgentHandle = INDEX_NONE;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+USDTAgentStateSubsystem* ASDTBaseAIController::GetAgentStates() const
+{
+    return GetWorld()->GetSubsystem<USDTAgentStateSubsystem>();
+}
+
+FPathFollowingRequestResult ASDTBaseAIController::MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath)
+{
+    const FPathFollowingRequestResult result = Super::MoveTo(MoveRequest, OutPath);
+
+    if (result.Code == EPathFollowingRequestResult::RequestSuccessful && m_AgentHandle != INDEX_NONE)
+    {
+        GetAgentStates()->SetAgentMoving(m_AgentHandle, true);
+    }
+    return result;
+}
+
+void ASDTBaseAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+    Super::OnMoveCompleted(RequestID, Result);
+
+    if (m_AgentHandle != INDEX_NONE)
     {
-        ShowNavigationPath();
+        GetAgentStates()->OnMoveCompleted(m_AgentHandle, Result);
     }
 }
 
@@ -33,6 +67,31 @@ AActor* ASDTBaseAIController::FindActorWithTag(FString actorTag, bool appendTag)
         actorTag.Append(m_TagToLookFor);
     }   
 
+    if (USDTTagRegistrySubsystem* registry = GetWorld()->GetSubsystem<USDTTagRegistrySubsystem>())
+    {
+        if (m_TagCacheGeneration != registry->GetTagsGeneration())
+        {
+            m_TagCache.Reset();
+            m_TagCacheGeneration = registry->GetTagsGeneration();
+        }
+
+        const FName tag(*actorTag);
+        if (const TWeakObjectPtr<AActor>* cached = m_TagCache.Find(tag))
+        {
+            if (cached->IsValid())
+            {
+                return cached->Get();
+            }
+        }
+
+        AActor* actor = registry->FindFirstActorWithTag(tag);
+        if (actor != nullptr)
+        {
+            m_TagCache.Add(tag, actor);
+        }
+        return actor;
+    }
+
     TArray<AActor*> foundActors;
     UGameplayStatics::GetAllActorsWithTag(this, *actorTag, foundActors);
 
@@ -45,8 +104,70 @@ AActor* ASDTBaseAIController::FindActorWithTag(FString actorTag, bool appendTag)
     }
 }
 
+void ASDTBaseAIController::OnAcquiredFromPool()
+{
+    m_TagCache.Reset();
+
+    if (m_AgentHandle != INDEX_NONE)
+    {
+        GetAgentStates()->ResetAgent(m_AgentHandle);
+    }
+}
+
+void ASDTBaseAIController::OnReleasedToPool()
+{
+    if (m_AgentHandle != INDEX_NONE)
+    {
+        GetAgentStates()->SleepAgent(m_AgentHandle);
+    }
+}
+
+void ASDTBaseAIController::MoveToTaggedActor(USDTAgentStateSubsystem& states, int32 agent, const FString& tag, bool appendTag)
+{
+    AActor* actor = FindActorWithTag(tag, appendTag);
+    states.SetTarget(agent, actor);
+
+    if (actor == nullptr || MoveToActor(actor) == EPathFollowingRequestResult::Failed)
+    {
+        states.RetryLater(agent);
+    }
+}
+
+bool ASDTBaseAIController::WaitForTaggedBridge(USDTAgentStateSubsystem& states, int32 agent, const FString& tag, bool appendTag, EBridgeState state)
+{
+    ASDTBridge* bridge = Cast<ASDTBridge>(FindActorWithTag(tag, appendTag));
+    if (bridge == nullptr)
+    {
+        states.RetryLater(agent);
+        return false;
+    }
+
+    return states.WaitForBridgeState(agent, bridge, state);
+}
+
+uint8 ASDTBaseAIController::Despawn(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+    APawn* pawn = controller.GetPawn();
+
+    // Pawn and controller go back to the pool together, state is reset on acquire
+    if (USDTActorPoolSubsystem* pool = controller.GetWorld()->GetSubsystem<USDTActorPoolSubsystem>())
+    {
+        pool->Release(pawn);
+    }
+    else
+    {
+        controller.UnPossess();
+        controller.Destroy();
+
+        pawn->Destroy();
+    }
+
+    return states.GetState(agent);
+}
+
 void ASDTBaseAIController::SetTagToLookFor(const FString& TagToLookFor)
 {
     m_TagToLookFor = TagToLookFor;
+    m_TagCache.Reset();
 }
 
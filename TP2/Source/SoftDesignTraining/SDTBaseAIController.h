@@ -4,31 +4,60 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "SDTActorPoolSubsystem.h"
+#include "SDTAgentStateSubsystem.h"
 #include "SDTBaseAIController.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class SOFTDESIGNTRAINING_API ASDTBaseAIController : public AAIController
+class SOFTDESIGNTRAINING_API ASDTBaseAIController : public AAIController, public ISDTPoolable
 {
 	GENERATED_BODY()
 
+    friend class USDTAgentStateSubsystem;
+
 public:
 
     ASDTBaseAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
-    virtual void Tick(float deltaTime) override;
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     void SetTagToLookFor(const FString& TagToLookFor);
+
+    // Keep USDTAgentStateSubsystem's list of moving agents up to date and raise its move completed event
+    virtual FPathFollowingRequestResult MoveTo(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr* OutPath = nullptr) override;
+    virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+
+    // ISDTPoolable
+    virtual void OnAcquiredFromPool() override;
+    virtual void OnReleasedToPool() override;
 	
 protected:
+    // Resolved through USDTTagRegistrySubsystem and cached per tag until the registry changes
     AActor* FindActorWithTag(FString actorTag, bool appendTag = true);
 
-    bool m_ReachedTarget;
+    // States and transitions run by USDTAgentStateSubsystem, one row per state
+    virtual FSDTAgentStateTable GetStateTable() const { return FSDTAgentStateTable(); }
+    USDTAgentStateSubsystem* GetAgentStates() const;
+
+    // Shared state actions: they make the agent the target of the state and retry it later if the
+    // tagged actor is missing or no move can be issued
+    void MoveToTaggedActor(USDTAgentStateSubsystem& states, int32 agent, const FString& tag, bool appendTag = true);
+    // Returns true once the tagged bridge is in the given state, until then the agent sleeps
+    bool WaitForTaggedBridge(USDTAgentStateSubsystem& states, int32 agent, const FString& tag, bool appendTag, EBridgeState state);
+    static uint8 Despawn(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+
     FString m_TagToLookFor;
 
+    // Handle of the agent's state, target and timer in USDTAgentStateSubsystem
+    int32 m_AgentHandle = INDEX_NONE;
+
 private:
-    virtual void GoToBestTarget(float deltaTime) {};
+    TMap<FName, TWeakObjectPtr<AActor>> m_TagCache;
+    uint32 m_TagCacheGeneration = 0;
+
     virtual void ChooseBehavior(float deltaTime) {};
     virtual void ShowNavigationPath() {};
 };
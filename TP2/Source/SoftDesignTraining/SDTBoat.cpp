@@ -7,9 +7,8 @@
 // Sets default values
 ASDTBoat::ASDTBoat()
 {
- 	// Set this pawn to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
+	// Nothing to update per frame: the container is emptied by the boat operator
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 // Called when the game starts or when spawned
@@ -18,10 +17,11 @@ void ASDTBoat::BeginPlay()
 	Super::BeginPlay();
 }
 
-// Called every frame
-void ASDTBoat::Tick(float DeltaTime)
+void ASDTBoat::OnAcquiredFromPool()
 {
-	Super::Tick(DeltaTime);
+	// A recycled boat comes back with a full container
+	m_Container = 1.f;
+	m_Accumulator = 0.f;
 }
 
 void ASDTBoat::UnloadContainer(float Amount)
@@ -29,6 +29,11 @@ void ASDTBoat::UnloadContainer(float Amount)
 	m_Container = FMath::Clamp(m_Container - Amount, 0.f, 1.f);
 }
 
+void ASDTBoat::SetContainerAmount(float Amount)
+{
+	m_Container = FMath::Clamp(Amount, 0.f, 1.f);
+}
+
 float ASDTBoat::GetContainerAmount() const
 {
 	return m_Container;
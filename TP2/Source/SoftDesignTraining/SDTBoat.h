@@ -4,10 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "SDTActorPoolSubsystem.h"
 #include "SDTBoat.generated.h"
 
 UCLASS()
-class SOFTDESIGNTRAINING_API ASDTBoat : public APawn
+class SOFTDESIGNTRAINING_API ASDTBoat : public APawn, public ISDTPoolable
 {
 	GENERATED_BODY()
 
@@ -16,10 +17,11 @@ public:
 	ASDTBoat();
 
 	void UnloadContainer(float Amount);
+	void SetContainerAmount(float Amount);
 	float GetContainerAmount() const;
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// ISDTPoolable
+	virtual void OnAcquiredFromPool() override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Boat")
 	float m_Container{ 1.f };
@@ -8,140 +8,143 @@
 #include "SDTBoat.h"
 
 #include "SDTBoatOperator.h"
+#include "SDTBoatDispatcherSubsystem.h"
 
-void ASDTBoatAIController::Tick(float deltaTime)
+FSDTAgentStateTable ASDTBoatAIController::GetStateTable() const
 {
-	Super::Tick(deltaTime);
+	// Action run in each state and state entered once its move succeeds
+	static const FSDTAgentStateRow rows[] =
+	{
+		{ &ASDTBoatAIController::Spawned,			uint8(BoatState::SPAWNED) },
+		{ &ASDTBoatAIController::GoToStartBridge,	uint8(BoatState::WAIT_AT_START_BRIDGE) },
+		{ &ASDTBoatAIController::WaitAtStartBridge,	uint8(BoatState::WAIT_AT_START_BRIDGE) },
+		{ &ASDTBoatAIController::WaitForOperator,	uint8(BoatState::WAIT_FOR_OPERATOR) },
+		{ &ASDTBoatAIController::GoToOperator,		uint8(BoatState::WAIT_AT_OPERATOR) },
+		{ &ASDTBoatAIController::WaitAtOperator,	uint8(BoatState::WAIT_AT_OPERATOR) },
+		{ &ASDTBoatAIController::GoToEndBridge,		uint8(BoatState::WAIT_AT_END_BRIDGE) },
+		{ &ASDTBoatAIController::WaitAtEndBridge,	uint8(BoatState::WAIT_AT_END_BRIDGE) },
+		{ &ASDTBoatAIController::GoToDespawn,		uint8(BoatState::DESPAWN) },
+		{ &ASDTBaseAIController::Despawn,			uint8(BoatState::DESPAWN) },
+	};
+	static_assert(UE_ARRAY_COUNT(rows) == static_cast<int32>(BoatState::DESPAWN) + 1, "One row per BoatState");
+
+	return { rows, UE_ARRAY_COUNT(rows) };
 }
 
-void ASDTBoatAIController::GoToBestTarget(float deltaTime)
+uint8 ASDTBoatAIController::Spawned(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
 {
-	APawn* pawn = GetPawn();
-	ASDTBoat* boat = Cast<ASDTBoat>(pawn);
+	return uint8(BoatState::GO_TO_START_BRIDGE);
+}
+
+uint8 ASDTBoatAIController::GoToStartBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	static_cast<ASDTBoatAIController&>(controller).MoveToTaggedActor(states, agent, TEXT("WaitPoint_Start_Water"), false);
+	return uint8(BoatState::GO_TO_START_BRIDGE);
+}
 
-	switch (m_BoatState)
+uint8 ASDTBoatAIController::WaitAtStartBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	// Once the bridge is up, we go through. Until then the agent sleeps.
+	if (static_cast<ASDTBoatAIController&>(controller).WaitForTaggedBridge(states, agent, TEXT("Bridge_0"), false, EBridgeState::BRIDGE_UP))
 	{
-		case BoatState::SPAWNED:
-		{
-			FString tag("WaitPoint_Start_Water");
-			AActor* actor = FindActorWithTag(tag, false);
-
-			if (actor != nullptr)
-			{
-				// TODO : Agents wants to move towards actor
-				
-				m_ReachedTarget = false;
-				MoveToActor(actor);
-				m_BoatState = BoatState::GO_TO_START_BRIDGE;
-			}
-
-			break;
-		}
-		case BoatState::GO_TO_START_BRIDGE:
-		{
-			// Nothing to do
-			break;
-		}
-		case BoatState::WAIT_AT_START_BRIDGE:
-		{
-			// Check if bridge is down
-			FString tag("Bridge_0");
-			AActor* actor = FindActorWithTag(tag, false);
-			ASDTBridge* bridge = Cast<ASDTBridge>(actor);
-
-			// Once the bridge is down, we go through
-			if (bridge != nullptr && bridge->GetState() == EBridgeState::BRIDGE_UP)
-			{
-				m_BoatState = BoatState::GO_TO_OPERATOR;
-			}
-
-			break;
-		}
-		case BoatState::GO_TO_OPERATOR:
-		{
-			TArray<AActor*> foundActors;
-			UGameplayStatics::GetAllActorsOfClass(this, ASDTBoatOperator::StaticClass(), foundActors);
-
-			for (AActor* actor : foundActors)
-			{
-				ASDTBoatOperator* boatOperator = Cast<ASDTBoatOperator>(actor);
-				if (boatOperator->IsAvailable())
-				{
-					boatOperator->Reserve(this);
-
-					// TODO : we want to move the agent towards the DropLocation of the boatOperator 
-					// Check ASDTBoatOperator::GetDropLocation to get the location.
-					// Note that m_ReachedTarget should be set to FALSE if the move is valid!
-
-					m_ReachedTarget = false;
-					MoveToLocation(boatOperator->GetDropLocation());
-					break;
-				}
-			}
-
-			break;
-		}
-		case BoatState::WAIT_AT_OPERATOR:
-		{
-			// Nothing to do, wait for notification to advance
-			break;
-		}
-		case BoatState::GO_TO_END_BRIDGE:
-		{
-			// Nothing to do
-			break;
-		}
-		case BoatState::WAIT_AT_END_BRIDGE:
-		{
-			// Check if bridge is down
-			FString tag("Bridge_1");
-			AActor* actor = FindActorWithTag(tag, false);
-			ASDTBridge* bridge = Cast<ASDTBridge>(actor);
-
-			// Once the bridge is down, we go through
-			if (bridge != nullptr && bridge->GetState() == EBridgeState::BRIDGE_UP)
-			{
-				m_BoatState = BoatState::GO_TO_DESPAWN;
-
-				tag = "WaitPoint_Water_2";
-				actor = FindActorWithTag(tag, false);
-				if (actor != nullptr)
-				{
-					// TODO : Agents wants to move towards actor
-					m_ReachedTarget = false;
-					MoveToActor(actor);
-				}
-			}
-
-			break;
-		}
-		case BoatState::GO_TO_DESPAWN:
+		return uint8(BoatState::WAIT_FOR_OPERATOR);
+	}
+	return uint8(BoatState::WAIT_AT_START_BRIDGE);
+}
+
+uint8 ASDTBoatAIController::WaitForOperator(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	ASDTBoatAIController& boatController = static_cast<ASDTBoatAIController&>(controller);
+
+	// Operators are handed out in arrival order, the boat sleeps until OnOperatorAssigned
+	if (USDTBoatDispatcherSubsystem* dispatcher = boatController.GetWorld()->GetSubsystem<USDTBoatDispatcherSubsystem>())
+	{
+		dispatcher->RequestOperator(&boatController);
+		return uint8(BoatState::WAIT_FOR_OPERATOR);
+	}
+
+	TArray<AActor*> foundActors;
+	UGameplayStatics::GetAllActorsOfClass(&boatController, ASDTBoatOperator::StaticClass(), foundActors);
+
+	for (AActor* actor : foundActors)
+	{
+		ASDTBoatOperator* boatOperator = Cast<ASDTBoatOperator>(actor);
+		if (boatOperator->IsAvailable())
 		{
-			// Nothing to do
-			break;
+			boatOperator->Reserve(&boatController);
+			states.SetTarget(agent, boatOperator);
+			return uint8(BoatState::GO_TO_OPERATOR);
 		}
-		case BoatState::DESPAWN:
-		{
-			UnPossess();
-			Destroy();
+	}
 
-			pawn->Destroy();
-			break;
-		}
+	states.RetryLater(agent);
+	return uint8(BoatState::WAIT_FOR_OPERATOR);
+}
+
+uint8 ASDTBoatAIController::GoToOperator(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	ASDTBoatOperator* boatOperator = Cast<ASDTBoatOperator>(states.GetTarget(agent));
+	if (boatOperator == nullptr)
+	{
+		return uint8(BoatState::WAIT_FOR_OPERATOR);
+	}
+
+	if (controller.MoveToLocation(boatOperator->GetDropLocation()) == EPathFollowingRequestResult::Failed)
+	{
+		states.RetryLater(agent);
+	}
+	return uint8(BoatState::GO_TO_OPERATOR);
+}
+
+uint8 ASDTBoatAIController::WaitAtOperator(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	// Nothing more to do until the operator calls NotifyUnloadComplete
+	if (ASDTBoatOperator* boatOperator = Cast<ASDTBoatOperator>(states.GetTarget(agent)))
+	{
+		boatOperator->NotifyBoatArrived();
 	}
+	return uint8(BoatState::WAIT_AT_OPERATOR);
+}
+
+uint8 ASDTBoatAIController::GoToEndBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	static_cast<ASDTBoatAIController&>(controller).MoveToTaggedActor(states, agent, TEXT("WaitPoint_End_Water"), false);
+	return uint8(BoatState::GO_TO_END_BRIDGE);
+}
+
+uint8 ASDTBoatAIController::WaitAtEndBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	// Once the bridge is up, we go through. Until then the agent sleeps.
+	if (static_cast<ASDTBoatAIController&>(controller).WaitForTaggedBridge(states, agent, TEXT("Bridge_1"), false, EBridgeState::BRIDGE_UP))
+	{
+		return uint8(BoatState::GO_TO_DESPAWN);
+	}
+	return uint8(BoatState::WAIT_AT_END_BRIDGE);
+}
+
+uint8 ASDTBoatAIController::GoToDespawn(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent)
+{
+	static_cast<ASDTBoatAIController&>(controller).MoveToTaggedActor(states, agent, TEXT("WaitPoint_Water_2"), false);
+	return uint8(BoatState::GO_TO_DESPAWN);
 }
 
 void ASDTBoatAIController::NotifyUnloadComplete()
 {
-	m_BoatState = BoatState::GO_TO_END_BRIDGE;
-	
-	FString tag("WaitPoint_End_Water");
-	AActor* actor = FindActorWithTag(tag, false);
-	if (actor != nullptr)
+	if (m_AgentHandle != INDEX_NONE)
+	{
+		USDTAgentStateSubsystem* states = GetAgentStates();
+		states->SetTarget(m_AgentHandle, nullptr);
+		states->SetState(m_AgentHandle, uint8(BoatState::GO_TO_END_BRIDGE));
+	}
+}
+
+void ASDTBoatAIController::OnOperatorAssigned(ASDTBoatOperator* boatOperator)
+{
+	if (m_AgentHandle != INDEX_NONE)
 	{
-		// TODO : Agents wants to move towards actor
-		m_ReachedTarget = false;
-		MoveToActor(actor);
+		USDTAgentStateSubsystem* states = GetAgentStates();
+		states->SetTarget(m_AgentHandle, boatOperator);
+		states->SetState(m_AgentHandle, uint8(BoatState::GO_TO_OPERATOR));
 	}
 }
 
@@ -149,9 +152,7 @@ void ASDTBoatAIController::ShowNavigationPath()
 {
 	// Show current navigation path DrawDebugLine and DrawDebugSphere
 	// Use the UPathFollowingComponent of the AIController to get the path
-	// This function is called while m_ReachedTarget is false 
-	// Check void ASDTBaseAIController::Tick for how it works.
-	if (m_ReachedTarget) return;
+	// This function is called by USDTAgentStateSubsystem while a move is in progress
 
 	UPathFollowingComponent* PathFollowingComp = GetPathFollowingComponent();
 	if (!PathFollowingComp) return;
@@ -192,43 +193,11 @@ void ASDTBoatAIController::ShowNavigationPath()
 
 BoatState ASDTBoatAIController::GetBoatState()
 {
-	return m_BoatState;
+	return m_AgentHandle != INDEX_NONE ? static_cast<BoatState>(GetAgentStates()->GetState(m_AgentHandle)) : BoatState::SPAWNED;
 }
 
 void ASDTBoatAIController::AIStateInterrupted()
 {
+	// The aborted move is issued again after the agent state subsystem's retry delay
 	StopMovement();
-
-	m_ReachedTarget = false;
 }
-
-void ASDTBoatAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
-{
-	Super::OnMoveCompleted(RequestID, Result);
-
-	m_ReachedTarget = true;
-
-	switch (m_BoatState)
-	{
-		case BoatState::GO_TO_START_BRIDGE:
-		{
-			m_BoatState = BoatState::WAIT_AT_START_BRIDGE;
-			break;
-		}
-		case BoatState::GO_TO_OPERATOR:
-		{
-			m_BoatState = BoatState::WAIT_AT_OPERATOR;
-			break;
-		}
-		case BoatState::GO_TO_END_BRIDGE:
-		{
-			m_BoatState = BoatState::WAIT_AT_END_BRIDGE;
-			break;
-		}
-		case BoatState::GO_TO_DESPAWN:
-		{
-			m_BoatState = BoatState::DESPAWN;
-			break;
-		}
-	}
-}
\ No newline at end of file
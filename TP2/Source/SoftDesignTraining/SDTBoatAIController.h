@@ -6,11 +6,14 @@
 #include "SDTBaseAIController.h"
 #include "SDTBoatAIController.generated.h"
 
-enum class BoatState
+class ASDTBoatOperator;
+
+enum class BoatState : uint8
 {
     SPAWNED,
     GO_TO_START_BRIDGE,
     WAIT_AT_START_BRIDGE,
+    WAIT_FOR_OPERATOR,
     GO_TO_OPERATOR,
     WAIT_AT_OPERATOR,
     GO_TO_END_BRIDGE,
@@ -27,18 +30,25 @@ class SOFTDESIGNTRAINING_API ASDTBoatAIController : public ASDTBaseAIController
 {
 	GENERATED_BODY()
 public:
-	virtual void Tick(float deltaTime) override;
-
     void NotifyUnloadComplete();
+    void OnOperatorAssigned(ASDTBoatOperator* boatOperator);
 
-    virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
     void AIStateInterrupted();
 
     BoatState GetBoatState();
 
 private:
-    virtual void GoToBestTarget(float deltaTime) override;
+    virtual FSDTAgentStateTable GetStateTable() const override;
     virtual void ShowNavigationPath() override;
 
-    BoatState m_BoatState{BoatState::SPAWNED};
+    // State actions, see GetStateTable. The operator reserved for this boat is the agent's target.
+    static uint8 Spawned(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 GoToStartBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 WaitAtStartBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 WaitForOperator(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 GoToOperator(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 WaitAtOperator(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 GoToEndBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 WaitAtEndBridge(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
+    static uint8 GoToDespawn(ASDTBaseAIController& controller, USDTAgentStateSubsystem& states, int32 agent);
 };
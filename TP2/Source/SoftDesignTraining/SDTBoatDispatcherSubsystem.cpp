@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTBoatDispatcherSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "SDTBoatAIController.h"
+#include "SDTBoatOperator.h"
+
+void USDTBoatDispatcherSubsystem::Deinitialize()
+{
+	m_FreeOperators.Empty();
+	m_WaitingBoats.Empty();
+	m_NumWaitingBoats = 0;
+	Super::Deinitialize();
+}
+
+bool USDTBoatDispatcherSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USDTBoatDispatcherSubsystem::RegisterOperator(ASDTBoatOperator* Operator)
+{
+	if (Operator != nullptr && Operator->IsAvailable())
+	{
+		ReleaseOperator(Operator);
+	}
+}
+
+void USDTBoatDispatcherSubsystem::UnregisterOperator(ASDTBoatOperator* Operator)
+{
+	m_FreeOperators.RemoveSingleSwap(Operator);
+}
+
+bool USDTBoatDispatcherSubsystem::RequestOperator(ASDTBoatAIController* Boat)
+{
+	while (m_FreeOperators.Num() > 0)
+	{
+		ASDTBoatOperator* boatOperator = m_FreeOperators.Pop().Get();
+		if (boatOperator != nullptr && boatOperator->IsAvailable())
+		{
+			Assign(boatOperator, Boat);
+			return true;
+		}
+	}
+
+	m_WaitingBoats.Enqueue(Boat);
+	++m_NumWaitingBoats;
+	return false;
+}
+
+void USDTBoatDispatcherSubsystem::ReleaseOperator(ASDTBoatOperator* Operator)
+{
+	TWeakObjectPtr<ASDTBoatAIController> waiting;
+	while (m_WaitingBoats.Dequeue(waiting))
+	{
+		--m_NumWaitingBoats;
+
+		ASDTBoatAIController* boat = waiting.Get();
+		if (boat != nullptr && boat->GetBoatState() == BoatState::WAIT_FOR_OPERATOR)
+		{
+			Assign(Operator, boat);
+			return;
+		}
+	}
+
+	m_FreeOperators.AddUnique(Operator);
+}
+
+void USDTBoatDispatcherSubsystem::Assign(ASDTBoatOperator* Operator, ASDTBoatAIController* Boat)
+{
+	Operator->Reserve(Boat);
+	Boat->OnOperatorAssigned(Operator);
+}
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "SDTBoatDispatcherSubsystem.generated.h"
+
+class ASDTBoatAIController;
+class ASDTBoatOperator;
+
+/**
+ * Hands boat operators out to boats in arrival order.
+ * Free operators sit on a free list, boats with no operator available wait in a FIFO. When an operator's
+ * reservation is cleared it goes straight to the next waiting boat, so no boat has to poll for one.
+ */
+UCLASS()
+class SOFTDESIGNTRAINING_API USDTBoatDispatcherSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterOperator(ASDTBoatOperator* Operator);
+	void UnregisterOperator(ASDTBoatOperator* Operator);
+
+	// Reserves a free operator for the boat, or queues the boat until one is released.
+	// Returns true if an operator was assigned right away.
+	bool RequestOperator(ASDTBoatAIController* Boat);
+
+	// Called when an operator's reservation is cleared
+	void ReleaseOperator(ASDTBoatOperator* Operator);
+
+	int32 GetNumWaitingBoats() const { return m_NumWaitingBoats; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void Assign(ASDTBoatOperator* Operator, ASDTBoatAIController* Boat);
+
+	TArray<TWeakObjectPtr<ASDTBoatOperator>> m_FreeOperators;
+
+	// Entries whose boat is gone or no longer waiting are skipped when dequeued
+	TQueue<TWeakObjectPtr<ASDTBoatAIController>> m_WaitingBoats;
+	int32 m_NumWaitingBoats = 0;
+};
@@ -3,12 +3,14 @@
 #include "SDTBoatOperator.h"
 #include "SDTBoatAIController.h"
 #include "SDTBoat.h"
+#include "SDTBoatDispatcherSubsystem.h"
 
 // Sets default values
 ASDTBoatOperator::ASDTBoatOperator()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	// Only ticks while unloading, see UpdateUnloading
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	m_RootComponent = CreateDefaultSubobject<USceneComponent>("RootComponent");
 	RootComponent = m_RootComponent;
@@ -21,6 +23,21 @@ ASDTBoatOperator::ASDTBoatOperator()
 void ASDTBoatOperator::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (USDTBoatDispatcherSubsystem* dispatcher = GetWorld()->GetSubsystem<USDTBoatDispatcherSubsystem>())
+	{
+		dispatcher->RegisterOperator(this);
+	}
+}
+
+void ASDTBoatOperator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USDTBoatDispatcherSubsystem* dispatcher = GetWorld()->GetSubsystem<USDTBoatDispatcherSubsystem>())
+	{
+		dispatcher->UnregisterOperator(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -28,37 +45,96 @@ void ASDTBoatOperator::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (m_BoatController == nullptr || !m_IsUnloading)
+	if (ASDTBoat* boat = GetReservedBoat())
 	{
-		return;
+		boat->SetContainerAmount(GetCurrentContainerAmount());
 	}
+}
 
-	ASDTBoat* boat = Cast<ASDTBoat>(m_BoatController->GetPawn());
+void ASDTBoatOperator::Activate()
+{
+	m_IsUnloading = true;
+	UpdateUnloading();
+}
 
-	if (boat == nullptr || m_BoatController->GetBoatState() != BoatState::WAIT_AT_OPERATOR)
+void ASDTBoatOperator::Deactivate()
+{
+	m_IsUnloading = false;
+	UpdateUnloading();
+}
+
+void ASDTBoatOperator::NotifyBoatArrived()
+{
+	UpdateUnloading();
+}
+
+ASDTBoat* ASDTBoatOperator::GetReservedBoat() const
+{
+	return m_BoatController != nullptr ? Cast<ASDTBoat>(m_BoatController->GetPawn()) : nullptr;
+}
+
+bool ASDTBoatOperator::CanUnload() const
+{
+	return m_IsUnloading
+		&& GetReservedBoat() != nullptr
+		&& m_BoatController->GetBoatState() == BoatState::WAIT_AT_OPERATOR;
+}
+
+float ASDTBoatOperator::GetCurrentContainerAmount() const
+{
+	const float elapsed = GetWorld()->GetTimeSeconds() - m_UnloadStartTime;
+	return FMath::Max(0.f, m_UnloadStartAmount - elapsed / FMath::Max(m_TimeToEmptyContainer, KINDA_SMALL_NUMBER));
+}
+
+void ASDTBoatOperator::UpdateUnloading()
+{
+	const bool canUnload = CanUnload();
+	if (canUnload == m_UnloadRunning)
 	{
 		return;
 	}
 
-	float amount = DeltaTime / m_TimeToEmptyContainer;
-	boat->UnloadContainer(amount); 
+	ASDTBoat* boat = GetReservedBoat();
+	FTimerManager& timerManager = GetWorldTimerManager();
 
-	float containerAmount = boat->GetContainerAmount();
-	if (FMath::IsNearlyZero(containerAmount))
+	if (canUnload)
 	{
-		m_BoatController->NotifyUnloadComplete();
-		ClearReservation();
+		m_UnloadStartTime = GetWorld()->GetTimeSeconds();
+		m_UnloadStartAmount = boat->GetContainerAmount();
+
+		// Single completion event instead of a per-frame check
+		const float remainingTime = m_UnloadStartAmount * m_TimeToEmptyContainer;
+		timerManager.SetTimer(m_UnloadCompleteTimer, this, &ASDTBoatOperator::OnUnloadComplete, FMath::Max(remainingTime, KINDA_SMALL_NUMBER), false);
+	}
+	else
+	{
+		// Paused: keep what was unloaded so far
+		if (boat != nullptr)
+		{
+			boat->SetContainerAmount(GetCurrentContainerAmount());
+		}
+		timerManager.ClearTimer(m_UnloadCompleteTimer);
 	}
-}
 
-void ASDTBoatOperator::Activate()
-{
-	m_IsUnloading = true;
+	m_UnloadRunning = canUnload;
+	SetActorTickEnabled(canUnload);
 }
 
-void ASDTBoatOperator::Deactivate()
+void ASDTBoatOperator::OnUnloadComplete()
 {
-	m_IsUnloading = false;
+	m_UnloadRunning = false;
+	SetActorTickEnabled(false);
+
+	if (ASDTBoat* boat = GetReservedBoat())
+	{
+		boat->SetContainerAmount(0.f);
+	}
+
+	if (m_BoatController != nullptr)
+	{
+		m_BoatController->NotifyUnloadComplete();
+	}
+	ClearReservation();
 }
 
 void ASDTBoatOperator::Reserve(ASDTBoatAIController* boatController)
@@ -79,6 +155,12 @@ bool ASDTBoatOperator::IsAvailable() const
 void ASDTBoatOperator::ClearReservation()
 {
 	m_BoatController = nullptr;
+
+	// Goes straight to the next waiting boat, if any
+	if (USDTBoatDispatcherSubsystem* dispatcher = GetWorld()->GetSubsystem<USDTBoatDispatcherSubsystem>())
+	{
+		dispatcher->ReleaseOperator(this);
+	}
 }
 
 FVector ASDTBoatOperator::GetDropLocation()
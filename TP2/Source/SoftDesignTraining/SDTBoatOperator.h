@@ -17,6 +17,7 @@ public:
 	// Sets default values for this actor's properties
 	ASDTBoatOperator();
 
+	// Only ticks while unloading, to show the container emptying
 	virtual void Tick(float DeltaTime) override;
 
 	void Activate();
@@ -26,6 +27,9 @@ public:
 	bool IsAvailable() const;
 	void ClearReservation();
 
+	// Called by the reserved boat once it waits at the drop point
+	void NotifyBoatArrived();
+
 	FVector GetDropLocation();
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -40,11 +44,26 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	class ASDTBoat* GetReservedBoat() const;
+	bool CanUnload() const;
+	float GetCurrentContainerAmount() const;
+
+	// Starts or pauses unloading when the operator activation or the boat changes
+	void UpdateUnloading();
+	void OnUnloadComplete();
+
 	ASDTBoatAIController* m_BoatController{ nullptr };
 
 	float m_Accumulator{ 0.f };
 
 	bool m_IsUnloading{ false };
+
+	// Unloading in progress: the container amount is a linear function of the time since m_UnloadStartTime
+	bool m_UnloadRunning{ false };
+	float m_UnloadStartTime{ 0.f };
+	float m_UnloadStartAmount{ 0.f };
+	FTimerHandle m_UnloadCompleteTimer;
 };
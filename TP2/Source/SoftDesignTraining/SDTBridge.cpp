@@ -2,12 +2,70 @@
 
 
 #include "SDTBridge.h"
+#include "SDTNavArea_BridgeRaised.h"
+#include "SoftDesignTraining.h"
+#include "NavigationSystem.h"
+#include "NavAreas/NavArea_Default.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+
+namespace
+{
+	// Height kept above the nav surface so the modifier covers the polys generated on top of it
+	constexpr float DeckNavHeightMargin = 50.f;
+}
 
 // Sets default values
 ASDTBridge::ASDTBridge()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// Only ticks while moving, see Activate
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	// Known before BeginPlay: the deck modifier is gathered as soon as the actor is registered
+	m_State = EBridgeState::BRIDGE_UP;
+	m_IsMoving = false;
+
+	m_WalkableArea = UNavArea_Default::StaticClass();
+	m_BlockedArea = USDTNavArea_BridgeRaised::StaticClass();
+
+	m_RootComponent = CreateDefaultSubobject<USceneComponent>("RootComponent");
+	RootComponent = m_RootComponent;
+
+	// Never collides, only exported to the navmesh generation
+	m_DeckNavSurface = CreateDefaultSubobject<UBoxComponent>("DeckNavSurface");
+	m_DeckNavSurface->SetupAttachment(RootComponent);
+	m_DeckNavSurface->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	m_DeckNavSurface->SetGenerateOverlapEvents(false);
+	m_DeckNavSurface->SetCustomNavigableGeometry(EHasCustomNavigableGeometry::EvenIfNotCollision);
+	m_DeckNavSurface->SetCanEverAffectNavigation(true);
+}
+
+void ASDTBridge::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	if (m_NavAreaExtent.IsNearlyZero())
+	{
+		UE_LOG(LogSoftDesignTraining, Warning, TEXT("%s: m_NavAreaExtent is not set, the bridge deck has no navmesh"), *GetName());
+	}
+
+	m_DeckNavSurface->SetRelativeLocation(m_NavAreaOffset);
+	m_DeckNavSurface->SetBoxExtent(m_NavAreaExtent);
+	m_DeckNavSurface->SetCanEverAffectNavigation(!m_NavAreaExtent.IsNearlyZero());
+
+	// The deck mesh rotates with the alpha, it must not dirty the navmesh nor carve it while raised
+	TInlineComponentArray<UPrimitiveComponent*> primitives(this);
+	for (UPrimitiveComponent* primitive : primitives)
+	{
+		if (primitive != m_DeckNavSurface)
+		{
+			primitive->SetCanEverAffectNavigation(false);
+		}
+	}
+
+	UpdateNavArea();
 }
 
 // Called when the game starts or when spawned
@@ -26,8 +84,10 @@ void ASDTBridge::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// Super::Tick has just let the blueprint apply the final alpha, the bridge can stop ticking
 	if (!m_IsMoving)
 	{
+		SetActorTickEnabled(false);
 		return;
 	}
 
@@ -37,8 +97,7 @@ void ASDTBridge::Tick(float DeltaTime)
 		if (m_BridgeOpeningAlpha > 1.f)
 		{
 			m_BridgeOpeningAlpha = 1.f;
-			m_IsMoving = false;
-			m_State = EBridgeState::BRIDGE_UP;
+			StopMoving(EBridgeState::BRIDGE_UP);
 		}
 	}
 	else if (m_State == EBridgeState::BRIDGE_GOING_DOWN)
@@ -47,8 +106,7 @@ void ASDTBridge::Tick(float DeltaTime)
 		if (m_BridgeOpeningAlpha < 0.f)
 		{
 			m_BridgeOpeningAlpha = 0.f;
-			m_IsMoving = false;
-			m_State = EBridgeState::BRIDGE_DOWN;
+			StopMoving(EBridgeState::BRIDGE_DOWN);
 		}
 	}
 }
@@ -62,17 +120,59 @@ void ASDTBridge::Activate()
 	else if (m_State == EBridgeState::BRIDGE_DOWN)
 	{
 		m_State = EBridgeState::BRIDGE_GOING_UP;
+		// Blocked as soon as it starts rising so no new path goes over it
+		UpdateNavArea();
 	}
 
 	m_IsMoving = true;
+	SetActorTickEnabled(true);
 }
 
 void ASDTBridge::Deactivate()
+{
+	// Tick stops on its own next frame, once the current alpha has been applied
+	m_IsMoving = false;
+}
+
+void ASDTBridge::StopMoving(EBridgeState finalState)
 {
 	m_IsMoving = false;
+	m_State = finalState;
+	// Keep ticking one more frame: the blueprint tick runs before Tick clamps the alpha,
+	// so the final pose is only applied by the next Super::Tick
+
+	UpdateNavArea();
+	m_OnStateChanged.Broadcast(this, m_State);
 }
 
 EBridgeState ASDTBridge::GetState() const
 {
 	return m_State;
-}
\ No newline at end of file
+}
+
+void ASDTBridge::GetNavigationData(FNavigationRelevantData& Data) const
+{
+	const TSubclassOf<UNavArea> areaClass = m_State == EBridgeState::BRIDGE_DOWN ? m_WalkableArea : m_BlockedArea;
+	if (areaClass != nullptr && IsNavigationRelevant())
+	{
+		Data.Modifiers.Add(FAreaNavModifier(GetNavigationBounds(), FTransform::Identity, areaClass));
+	}
+}
+
+FBox ASDTBridge::GetNavigationBounds() const
+{
+	// Follows the nav surface, which is attached to the root and not to the moving deck
+	const FBox surfaceBox = m_DeckNavSurface->CalcBounds(m_DeckNavSurface->GetComponentTransform()).GetBox();
+	return FBox(surfaceBox.Min, surfaceBox.Max + FVector(0.f, 0.f, DeckNavHeightMargin));
+}
+
+bool ASDTBridge::IsNavigationRelevant() const
+{
+	return !m_NavAreaExtent.IsNearlyZero();
+}
+
+void ASDTBridge::UpdateNavArea()
+{
+	// Goes through the navigation system's dirty areas: the tile rebuild is synchronized with path queries
+	FNavigationSystem::UpdateActorData(*this);
+}
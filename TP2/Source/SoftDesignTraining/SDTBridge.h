@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "AI/NavigationModifier.h"
+#include "AI/Navigation/NavRelevantInterface.h"
 #include "SDTBridge.generated.h"
 
 enum class EBridgeState
@@ -14,8 +16,10 @@ enum class EBridgeState
 	BRIDGE_DOWN
 };
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FSDTBridgeStateChanged, class ASDTBridge*, EBridgeState);
+
 UCLASS()
-class SOFTDESIGNTRAINING_API ASDTBridge : public AActor
+class SOFTDESIGNTRAINING_API ASDTBridge : public AActor, public INavRelevantInterface
 {
 	GENERATED_BODY()
 	
@@ -23,6 +27,8 @@ public:
 	// Sets default values for this actor's properties
 	ASDTBridge();
 
+	// Places the deck nav surface and keeps the moving deck out of navigation
+	virtual void OnConstruction(const FTransform& Transform) override;
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	// Called every frame
@@ -33,7 +39,23 @@ public:
 
 	EBridgeState GetState() const;
 
+	// Broadcast when the bridge finishes going up or down
+	FSDTBridgeStateChanged& OnStateChanged() { return m_OnStateChanged; }
+
+	// INavRelevantInterface: the deck is an area modifier, walkable only while the bridge is down.
+	// This is not free: every state change regenerates the navmesh tiles under the modifier.
+	virtual void GetNavigationData(FNavigationRelevantData& Data) const override;
+	virtual FBox GetNavigationBounds() const override;
+	virtual bool IsNavigationRelevant() const override;
+
 protected:
+	void StopMoving(EBridgeState finalState);
+
+	// Marks the deck modifier dirty, the navigation system then rebuilds the tiles under it
+	void UpdateNavArea();
+
+	FSDTBridgeStateChanged m_OnStateChanged;
+
 	EBridgeState m_State;
 	bool m_IsMoving;
 
@@ -42,4 +64,27 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bridge")
 	float m_BridgeOpenningSpeed;
+
+	// Area of the deck while the bridge is down
+	UPROPERTY(EditAnywhere, Category = "Bridge|Navigation")
+	TSubclassOf<class UNavArea> m_WalkableArea;
+
+	// Area of the deck while the bridge is up or moving
+	UPROPERTY(EditAnywhere, Category = "Bridge|Navigation")
+	TSubclassOf<class UNavArea> m_BlockedArea;
+
+	// Half extent of the lowered deck, required: the bridge has no nav surface while it is zero
+	UPROPERTY(EditAnywhere, Category = "Bridge|Navigation")
+	FVector m_NavAreaExtent = FVector::ZeroVector;
+
+	// Center of the lowered deck relative to the actor
+	UPROPERTY(EditAnywhere, Category = "Bridge|Navigation")
+	FVector m_NavAreaOffset = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Bridge")
+	USceneComponent* m_RootComponent;
+
+	// Static nav-only box under the lowered deck: the deck polys exist whatever pose the deck mesh is in
+	UPROPERTY(VisibleAnywhere, Category = "Bridge|Navigation")
+	class UBoxComponent* m_DeckNavSurface;
 };
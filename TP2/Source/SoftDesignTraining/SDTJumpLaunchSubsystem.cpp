@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTJumpLaunchSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "EngineUtils.h"
+#include "NavigationSystem.h"
+#include "Navigation/NavLinkProxy.h"
+#include "Kismet/GameplayStatics.h"
+
+void USDTJumpLaunchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		navSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &USDTJumpLaunchSubsystem::OnNavigationGenerationFinished);
+	}
+
+	Rebuild();
+}
+
+void USDTJumpLaunchSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		navSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &USDTJumpLaunchSubsystem::OnNavigationGenerationFinished);
+	}
+
+	m_Solutions.Empty();
+	m_SolutionsByStartCell.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTJumpLaunchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USDTJumpLaunchSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	Rebuild();
+}
+
+void USDTJumpLaunchSubsystem::Rebuild()
+{
+	m_Solutions.Reset();
+	m_SolutionsByStartCell.Reset();
+
+	for (TActorIterator<ANavLinkProxy> it(GetWorld()); it; ++it)
+	{
+		const FTransform& transform = it->GetActorTransform();
+		for (const FNavigationLink& link : it->PointLinks)
+		{
+			const FVector left = transform.TransformPosition(link.Left);
+			const FVector right = transform.TransformPosition(link.Right);
+
+			if (link.Direction != ENavLinkDirection::RightToLeft)
+			{
+				Solve(left, right);
+			}
+			if (link.Direction != ENavLinkDirection::LeftToRight)
+			{
+				Solve(right, left);
+			}
+		}
+	}
+
+	UE_LOG(LogSoftDesignTraining, Log, TEXT("SDTJumpLaunch: %d jump links solved"), m_Solutions.Num());
+}
+
+FIntVector USDTJumpLaunchSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / MatchTolerance),
+		FMath::FloorToInt(Location.Y / MatchTolerance),
+		FMath::FloorToInt(Location.Z / MatchTolerance));
+}
+
+const USDTJumpLaunchSubsystem::FLaunchSolution* USDTJumpLaunchSubsystem::FindSolution(const FVector& LinkStart, const FVector& LinkEnd) const
+{
+	const float toleranceSquared = FMath::Square(MatchTolerance);
+	const FIntVector cell = GetCell(LinkStart);
+
+	const FLaunchSolution* bestSolution = nullptr;
+	float bestDistance = FLT_MAX;
+
+	// A point within MatchTolerance of LinkStart is at most one cell away on each axis
+	for (int32 x = -1; x <= 1; ++x)
+	{
+		for (int32 y = -1; y <= 1; ++y)
+		{
+			for (int32 z = -1; z <= 1; ++z)
+			{
+				for (auto it = m_SolutionsByStartCell.CreateConstKeyIterator(cell + FIntVector(x, y, z)); it; ++it)
+				{
+					const FLaunchSolution& solution = m_Solutions[it.Value()];
+					const float startDistance = FVector::DistSquared(solution.Start, LinkStart);
+					const float endDistance = FVector::DistSquared(solution.End, LinkEnd);
+
+					if (startDistance <= toleranceSquared && endDistance <= toleranceSquared && startDistance + endDistance < bestDistance)
+					{
+						bestDistance = startDistance + endDistance;
+						bestSolution = &solution;
+					}
+				}
+			}
+		}
+	}
+
+	return bestSolution;
+}
+
+const USDTJumpLaunchSubsystem::FLaunchSolution* USDTJumpLaunchSubsystem::Solve(const FVector& LinkStart, const FVector& LinkEnd)
+{
+	FVector velocity;
+	if (!UGameplayStatics::SuggestProjectileVelocity_CustomArc(GetWorld(), velocity, LinkStart, LinkEnd, 0.f, ArcParam))
+	{
+		return nullptr;
+	}
+
+	// A (nearly) vertical launch has no usable flight time for the offset correction
+	const float horizontalSpeed = velocity.Size2D();
+	if (horizontalSpeed < KINDA_SMALL_NUMBER)
+	{
+		return nullptr;
+	}
+
+	const float flightTime = FVector::Dist2D(LinkStart, LinkEnd) / horizontalSpeed;
+	const int32 index = m_Solutions.Add({ LinkStart, LinkEnd, velocity, flightTime });
+	m_SolutionsByStartCell.Add(GetCell(LinkStart), index);
+	return &m_Solutions[index];
+}
+
+bool USDTJumpLaunchSubsystem::GetLaunchVelocity(const FVector& LinkStart, const FVector& LinkEnd, const FVector& LaunchLocation, FVector& OutVelocity)
+{
+	const FLaunchSolution* solution = FindSolution(LinkStart, LinkEnd);
+	if (solution == nullptr)
+	{
+		solution = Solve(LinkStart, LinkEnd);
+	}
+
+	if (solution == nullptr)
+	{
+		return UGameplayStatics::SuggestProjectileVelocity_CustomArc(GetWorld(), OutVelocity, LaunchLocation, LinkEnd, 0.f, ArcParam);
+	}
+
+	OutVelocity = solution->Velocity - (LaunchLocation - solution->Start) / solution->FlightTime;
+	return true;
+}
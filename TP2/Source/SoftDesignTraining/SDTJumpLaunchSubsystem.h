@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTJumpLaunchSubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ * Launch velocities for jump nav links, solved once per link instead of once per jump.
+ * Entries are built from the level's ANavLinkProxy point links whenever the navmesh finishes building.
+ * The path points of a link are its endpoints snapped to the navmesh, so a lookup matches a solution whose
+ * endpoints are both within MatchTolerance: solutions are indexed by start cell (cell size MatchTolerance)
+ * and the neighbouring cells are probed. Links missing from the table are solved and added on first use.
+ *
+ * The stored solution goes from the link start point. An agent launching from a slightly different
+ * point (capsule height, arrival offset) reuses it with the same flight time T: v' = v - offset / T
+ * still lands on the link end under the same gravity.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTJumpLaunchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Launch velocity from LaunchLocation for the link going from LinkStart to LinkEnd
+	bool GetLaunchVelocity(const FVector& LinkStart, const FVector& LinkEnd, const FVector& LaunchLocation, FVector& OutVelocity);
+
+	void Rebuild();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	// Same arc as the original per-jump solve
+	UPROPERTY(Config)
+	float ArcParam = 0.3f;
+
+	// Maximum distance between a link endpoint and the path point snapped from it
+	UPROPERTY(Config)
+	float MatchTolerance = 50.f;
+
+private:
+	struct FLaunchSolution
+	{
+		FVector Start;
+		FVector End;
+		FVector Velocity;
+		float FlightTime;
+	};
+
+	FIntVector GetCell(const FVector& Location) const;
+	// Closest solution with both endpoints within MatchTolerance, nullptr if none
+	const FLaunchSolution* FindSolution(const FVector& LinkStart, const FVector& LinkEnd) const;
+	const FLaunchSolution* Solve(const FVector& LinkStart, const FVector& LinkEnd);
+
+	TArray<FLaunchSolution> m_Solutions;
+	TMultiMap<FIntVector, int32> m_SolutionsByStartCell;
+};
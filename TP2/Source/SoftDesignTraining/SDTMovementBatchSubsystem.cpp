@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTMovementBatchSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "Async/ParallelFor.h"
+
+void USDTMovementBatchSubsystem::Deinitialize()
+{
+	m_Moves.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTMovementBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTMovementBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTMovementBatchSubsystem, STATGROUP_Tickables);
+}
+
+void USDTMovementBatchSubsystem::QueueMove(APawn* Pawn, const FVector& TargetLocation, const FMoveSettings& Settings, float DeltaTime)
+{
+	m_Moves.Add({ Pawn->GetRootComponent(), Pawn->GetActorLocation(), Pawn->GetActorRotation(), TargetLocation, Settings, DeltaTime });
+}
+
+FVector USDTMovementBatchSubsystem::ComputeLocation(const FVector& Location, const FVector& TargetLocation, const FMoveSettings& Settings, float DeltaTime)
+{
+	FVector direction = TargetLocation - Location;
+	direction.Z = 0.f;
+	const float distanceToTarget = direction.Size();
+	direction.Normalize();
+
+	float velocity = Settings.MaxSpeed;
+	if (distanceToTarget < Settings.SlowDownDistance)
+	{
+		const float slowDownFactor = distanceToTarget / Settings.SlowDownDistance;
+		velocity = FMath::Lerp(Settings.MinSpeed, Settings.MaxSpeed, slowDownFactor);
+	}
+
+	return Location + direction * velocity * DeltaTime;
+}
+
+FRotator USDTMovementBatchSubsystem::ComputeRotation(const FRotator& Rotation, const FVector& Location, const FVector& TargetLocation, const FMoveSettings& Settings, float DeltaTime)
+{
+	const FRotator goalRotation = (TargetLocation - Location).Rotation();
+	const FRotator flatGoalRotation(0.f, goalRotation.Yaw, 0.f);
+
+	return FMath::RInterpTo(Rotation, flatGoalRotation, DeltaTime, Settings.RotationRate);
+}
+
+void USDTMovementBatchSubsystem::Tick(float DeltaTime)
+{
+	const int32 count = m_Moves.Num();
+	if (count == 0)
+	{
+		return;
+	}
+
+	FMove* moves = m_Moves.GetData();
+	ParallelFor(count, [moves](int32 index)
+	{
+		FMove& move = moves[index];
+		move.Location = ComputeLocation(move.Location, move.TargetLocation, move.Settings, move.DeltaTime);
+		move.Rotation = ComputeRotation(move.Rotation, move.Location, move.TargetLocation, move.Settings, move.DeltaTime);
+	}, count < MinParallelAgents);
+
+	for (const FMove& move : m_Moves)
+	{
+		if (USceneComponent* root = move.Root.Get())
+		{
+			root->SetWorldLocationAndRotationNoPhysics(move.Location, move.Rotation);
+		}
+	}
+
+	m_Moves.Reset();
+}
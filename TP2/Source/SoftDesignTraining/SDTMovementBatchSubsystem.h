@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTMovementBatchSubsystem.generated.h"
+
+/**
+ * Batched kinematic movement for agents following a path on the ground.
+ * USDTPathFollowingComponent queues the segment target of its pawn instead of moving it; once all actors
+ * have ticked, the new transforms are computed in a ParallelFor and applied in one game thread pass.
+ * The pass sets the root component transform directly (SetWorldLocationAndRotationNoPhysics): no sweep,
+ * no physics teleport and no overlap update, the agents are moved kinematically along the navmesh.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTMovementBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	struct FMoveSettings
+	{
+		float MaxSpeed;
+		float MinSpeed;
+		float SlowDownDistance;
+		float RotationRate;
+	};
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Moves the pawn towards TargetLocation (and turns it to face it) at the end of the frame
+	void QueueMove(APawn* Pawn, const FVector& TargetLocation, const FMoveSettings& Settings, float DeltaTime);
+
+	// Same kinematics as the batch, for a single pawn
+	static FVector ComputeLocation(const FVector& Location, const FVector& TargetLocation, const FMoveSettings& Settings, float DeltaTime);
+	static FRotator ComputeRotation(const FRotator& Rotation, const FVector& Location, const FVector& TargetLocation, const FMoveSettings& Settings, float DeltaTime);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Below this many moves, the transforms are computed on the game thread
+	UPROPERTY(Config)
+	int32 MinParallelAgents = 64;
+
+private:
+	struct FMove
+	{
+		TWeakObjectPtr<USceneComponent> Root;
+		FVector Location;
+		FRotator Rotation;
+		FVector TargetLocation;
+		FMoveSettings Settings;
+		float DeltaTime;
+	};
+
+	TArray<FMove> m_Moves;
+};
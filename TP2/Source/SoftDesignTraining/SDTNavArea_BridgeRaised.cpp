@@ -0,0 +1,15 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTNavArea_BridgeRaised.h"
+#include "SoftDesignTraining.h"
+
+USDTNavArea_BridgeRaised::USDTNavArea_BridgeRaised(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    DefaultCost = BIG_NUMBER;
+    // No flag: the polys fail every query filter, like the null area but without being cut out of the tile
+    AreaFlags = 0;
+
+    // Boats (second supported agent) sail under the raised deck
+    SupportedAgents.bSupportsAgent1 = false;
+}
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavAreas/NavArea.h"
+#include "SDTNavArea_BridgeRaised.generated.h"
+
+/**
+ * Deck of a bridge that is up or moving: unwalkable for pedestrians, ignored by the boat navmesh
+ */
+UCLASS()
+class SOFTDESIGNTRAINING_API USDTNavArea_BridgeRaised : public UNavArea
+{
+	GENERATED_BODY()
+	
+public:
+    USDTNavArea_BridgeRaised(const FObjectInitializer& ObjectInitializer);
+};
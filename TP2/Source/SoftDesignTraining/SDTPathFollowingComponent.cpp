@@ -9,6 +9,7 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "SDTJumpLaunchSubsystem.h"
 
 USDTPathFollowingComponent::USDTPathFollowingComponent(const FObjectInitializer& ObjectInitializer)
 {
@@ -127,9 +128,16 @@ if (SDTUtils::HasJumpFlag(segmentStart))
         // We are approaching a non navlink point on the ground, normal movement
         else
         {
-            // Update navigation along path (move along)
-            MoveTowardsTarget(segmentEnd.Location, DeltaTime);
-            UpdateRotation(segmentEnd.Location, DeltaTime);
+            // Update navigation along path (move along), applied with the other agents at the end of the frame
+            if (USDTMovementBatchSubsystem* movementBatch = GetWorld()->GetSubsystem<USDTMovementBatchSubsystem>())
+            {
+                movementBatch->QueueMove(pawn, segmentEnd.Location, GetMoveSettings(), DeltaTime);
+            }
+            else
+            {
+                MoveTowardsTarget(segmentEnd.Location, DeltaTime);
+                UpdateRotation(segmentEnd.Location, DeltaTime);
+            }
         }
     }
 }
@@ -162,15 +170,24 @@ void USDTPathFollowingComponent::SetMoveSegment(int32 segmentStartIndex)
                         FVector LaunchVelocity;
                         FVector PlayerLocation = Pawn->GetActorLocation();
                         
-                        // Finds a launch trajectory for desired start, end locations. Returns false if it could not find a suitable velocity
-                        bool bSuccess = UGameplayStatics::SuggestProjectileVelocity_CustomArc(
-                            GetWorld(),
-                            LaunchVelocity,
-                            PlayerLocation,
-                            segmentEnd.Location,
-                            0.0f,
-                            0.3f
-                        );
+                        bool bSuccess = false;
+                        if (USDTJumpLaunchSubsystem* JumpLaunch = GetWorld()->GetSubsystem<USDTJumpLaunchSubsystem>())
+                        {
+                            // Solved once per link, corrected for where we actually launch from
+                            bSuccess = JumpLaunch->GetLaunchVelocity(segmentStart.Location, segmentEnd.Location, PlayerLocation, LaunchVelocity);
+                        }
+                        else
+                        {
+                            // Finds a launch trajectory for desired start, end locations. Returns false if it could not find a suitable velocity
+                            bSuccess = UGameplayStatics::SuggestProjectileVelocity_CustomArc(
+                                GetWorld(),
+                                LaunchVelocity,
+                                PlayerLocation,
+                                segmentEnd.Location,
+                                0.0f,
+                                0.3f
+                            );
+                        }
 
                         if (bSuccess)
                         {
@@ -191,6 +208,11 @@ void USDTPathFollowingComponent::SetMoveSegment(int32 segmentStartIndex)
     }
 }
 
+USDTMovementBatchSubsystem::FMoveSettings USDTPathFollowingComponent::GetMoveSettings() const
+{
+    return { m_MaxSpeed, m_MinSpeed, m_SlowDownDistance, m_RotationRate };
+}
+
 void USDTPathFollowingComponent::MoveTowardsTarget(const FVector& TargetLocation, const float DeltaTime) const
 {
     if (AActor* Owner = GetOwner())
@@ -199,20 +221,7 @@ void USDTPathFollowingComponent::MoveTowardsTarget(const FVector& TargetLocation
         {
             if (APawn* Pawn = Controller->GetPawn())
             {
-                const FVector CurrentLocation = Pawn->GetActorLocation();
-                FVector Direction = (TargetLocation - CurrentLocation);
-                Direction.Z = 0.f;
-                const float DistanceToTarget = Direction.Size();
-                Direction.Normalize();
-
-                float Velocity = m_MaxSpeed;
-                if (DistanceToTarget < m_SlowDownDistance)
-                {
-                    const float SlowDownFactor = DistanceToTarget / m_SlowDownDistance;
-                    Velocity = FMath::Lerp(m_MinSpeed, m_MaxSpeed, SlowDownFactor);
-                }
-                
-                const FVector NewLocation = CurrentLocation + Direction * Velocity * DeltaTime;
+                const FVector NewLocation = USDTMovementBatchSubsystem::ComputeLocation(Pawn->GetActorLocation(), TargetLocation, GetMoveSettings(), DeltaTime);
                 Pawn->SetActorLocation(NewLocation, false); 
             }
         }
@@ -227,14 +236,9 @@ void USDTPathFollowingComponent::UpdateRotation(const FVector& TargetLocation, f
         {
             if (APawn* Pawn = Controller->GetPawn())
             {
-                const FRotator CurrentRotation = Pawn->GetActorRotation();
-                const FVector ToTarget = TargetLocation - Pawn->GetActorLocation();
-                const FRotator GoalRotation = ToTarget.Rotation();
-                FRotator FlatGoalRotation = FRotator(0.f, GoalRotation.Yaw, 0.f);
-                
-                const FRotator NewRotation = FMath::RInterpTo(CurrentRotation, FlatGoalRotation, DeltaTime, m_RotationRate);
+                const FRotator NewRotation = USDTMovementBatchSubsystem::ComputeRotation(Pawn->GetActorRotation(), Pawn->GetActorLocation(), TargetLocation, GetMoveSettings(), DeltaTime);
                 Pawn->SetActorRotation(NewRotation);
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "SDTMovementBatchSubsystem.h"
 #include "SDTPathFollowingComponent.generated.h"
 
 /**
@@ -36,6 +37,8 @@ public:
     UPROPERTY(BlueprintReadOnly)
     bool isJumping{ false };
 private:
+    USDTMovementBatchSubsystem::FMoveSettings GetMoveSettings() const;
+
     void MoveTowardsTarget(const FVector& TargetLocation, const float DeltaTime) const;
     void UpdateRotation(const FVector& TargetLocation, float DeltaTime) const;
 };
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTSpawnSchedulerSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "SDTAISpawner.h"
+#include "SDTActorPoolSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued spawns"), STAT_SDTSpawnQueueDepth, STATGROUP_SDTSpawn);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued prewarms"), STAT_SDTPrewarmQueueDepth, STATGROUP_SDTSpawn);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawns this frame"), STAT_SDTSpawnsThisFrame, STATGROUP_SDTSpawn);
+DECLARE_CYCLE_STAT(TEXT("Spawn scheduler"), STAT_SDTSpawnScheduler, STATGROUP_SDTSpawn);
+
+void USDTSpawnSchedulerSubsystem::Deinitialize()
+{
+	m_SpawnQueue.Empty();
+	m_PrewarmQueue.Empty();
+	m_NumQueuedSpawns = 0;
+	m_NumQueuedPrewarms = 0;
+
+	for (const TSharedPtr<FStreamableHandle>& handle : m_PreloadHandles)
+	{
+		if (handle.IsValid())
+		{
+			handle->ReleaseHandle();
+		}
+	}
+	m_PreloadHandles.Empty();
+
+	Super::Deinitialize();
+}
+
+bool USDTSpawnSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTSpawnSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTSpawnSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void USDTSpawnSchedulerSubsystem::RequestSpawn(ASDTAISpawner* Spawner)
+{
+	m_SpawnQueue.Enqueue(Spawner);
+	++m_NumQueuedSpawns;
+}
+
+void USDTSpawnSchedulerSubsystem::RequestPreload(const TSoftClassPtr<APawn>& Class, int32 PrewarmCount, const FTransform& Transform)
+{
+	if (Class.IsNull())
+	{
+		return;
+	}
+
+	if (UClass* loadedClass = Class.Get())
+	{
+		QueuePrewarms(loadedClass, PrewarmCount, Transform);
+		return;
+	}
+
+	// Loaded asynchronously during map load, prewarms are queued once the class is resident
+	TWeakObjectPtr<USDTSpawnSchedulerSubsystem> weakThis(this);
+	m_PreloadHandles.Add(UAssetManager::GetStreamableManager().RequestAsyncLoad(Class.ToSoftObjectPath(),
+		FStreamableDelegate::CreateLambda([weakThis, Class, PrewarmCount, Transform]()
+		{
+			if (weakThis.IsValid())
+			{
+				weakThis->QueuePrewarms(Class.Get(), PrewarmCount, Transform);
+			}
+		})));
+}
+
+void USDTSpawnSchedulerSubsystem::QueuePrewarms(UClass* Class, int32 PrewarmCount, const FTransform& Transform)
+{
+	if (Class == nullptr)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < PrewarmCount; ++i)
+	{
+		m_PrewarmQueue.Enqueue({ Class, Transform });
+		++m_NumQueuedPrewarms;
+	}
+}
+
+void USDTSpawnSchedulerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SDTSpawnScheduler);
+
+	const double startTime = FPlatformTime::Seconds();
+	const double budget = SpawnBudgetMs / 1000.0;
+
+	int32 numProcessed = 0;
+	int32 numSpawned = 0;
+	auto hasBudget = [&]()
+	{
+		return numProcessed == 0 || (numProcessed < MaxSpawnsPerFrame && FPlatformTime::Seconds() - startTime < budget);
+	};
+
+	TWeakObjectPtr<ASDTAISpawner> spawner;
+	while (hasBudget() && m_SpawnQueue.Peek(spawner))
+	{
+		// Spawns keep their order: wait until the class at the front is resident
+		if (spawner.IsValid() && !spawner->IsReadyToSpawn())
+		{
+			break;
+		}
+
+		m_SpawnQueue.Pop();
+		--m_NumQueuedSpawns;
+
+		if (spawner.IsValid())
+		{
+			spawner->Spawn();
+			++numProcessed;
+			++numSpawned;
+		}
+	}
+
+	USDTActorPoolSubsystem* pool = GetWorld()->GetSubsystem<USDTActorPoolSubsystem>();
+
+	FPrewarmRequest prewarm;
+	while (hasBudget() && m_PrewarmQueue.Dequeue(prewarm))
+	{
+		--m_NumQueuedPrewarms;
+
+		if (pool != nullptr && prewarm.Class.IsValid())
+		{
+			pool->Prewarm(prewarm.Class.Get(), 1, prewarm.Transform);
+			++numProcessed;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SDTSpawnQueueDepth, m_NumQueuedSpawns);
+	SET_DWORD_STAT(STAT_SDTPrewarmQueueDepth, m_NumQueuedPrewarms);
+	SET_DWORD_STAT(STAT_SDTSpawnsThisFrame, numSpawned);
+}
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "Engine/StreamableManager.h"
+#include "Stats/Stats.h"
+#include "SDTSpawnSchedulerSubsystem.generated.h"
+
+class ASDTAISpawner;
+class APawn;
+
+DECLARE_STATS_GROUP(TEXT("SDTSpawn"), STATGROUP_SDTSpawn, STATCAT_Advanced);
+
+/**
+ * Collects spawn requests from every ASDTAISpawner and runs them under a per-frame budget
+ * (MaxSpawnsPerFrame and SpawnBudgetMs), so a wave of spawners firing together is spread over
+ * several frames instead of stalling one. Preload requests load the spawner's soft AI class
+ * asynchronously through the asset manager, then prewarm the actor pool one actor at a time
+ * with whatever budget spawns leave over. A spawn whose class is still loading waits in the queue.
+ *
+ * "stat SDTSpawn" shows the queue depths and the time spent per frame.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTSpawnSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RequestSpawn(ASDTAISpawner* Spawner);
+
+	// Starts loading the class asynchronously, PrewarmCount pooled instances are queued once it is resident
+	void RequestPreload(const TSoftClassPtr<APawn>& Class, int32 PrewarmCount, const FTransform& Transform);
+
+	int32 GetNumQueuedSpawns() const { return m_NumQueuedSpawns; }
+	int32 GetNumQueuedPrewarms() const { return m_NumQueuedPrewarms; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// At least one request is always processed per frame, whatever the budgets
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 2;
+
+	UPROPERTY(Config)
+	float SpawnBudgetMs = 2.f;
+
+private:
+	void QueuePrewarms(UClass* Class, int32 PrewarmCount, const FTransform& Transform);
+
+	struct FPrewarmRequest
+	{
+		TWeakObjectPtr<UClass> Class;
+		FTransform Transform;
+	};
+
+	TQueue<TWeakObjectPtr<ASDTAISpawner>> m_SpawnQueue;
+	int32 m_NumQueuedSpawns = 0;
+
+	TQueue<FPrewarmRequest> m_PrewarmQueue;
+	int32 m_NumQueuedPrewarms = 0;
+
+	// Keeps the preloaded classes resident for the lifetime of the world
+	TArray<TSharedPtr<FStreamableHandle>> m_PreloadHandles;
+};
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SDTTagRegistrySubsystem.h"
+#include "SoftDesignTraining.h"
+#include "EngineUtils.h"
+
+void USDTTagRegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		AddActor(*It);
+	}
+
+	m_ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USDTTagRegistrySubsystem::OnActorSpawned));
+	m_ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &USDTTagRegistrySubsystem::OnActorDestroyed));
+}
+
+void USDTTagRegistrySubsystem::Deinitialize()
+{
+	if (UWorld* world = GetWorld())
+	{
+		world->RemoveOnActorSpawnedHandler(m_ActorSpawnedHandle);
+		world->RemoveOnActorDestroyedHandler(m_ActorDestroyedHandle);
+	}
+
+	m_TagToActors.Empty();
+	m_IndexedTags.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTTagRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USDTTagRegistrySubsystem::OnActorSpawned(AActor* Actor)
+{
+	AddActor(Actor);
+}
+
+void USDTTagRegistrySubsystem::OnActorDestroyed(AActor* Actor)
+{
+	RemoveActor(Actor);
+}
+
+void USDTTagRegistrySubsystem::AddActor(AActor* Actor)
+{
+	if (Actor == nullptr || Actor->Tags.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<FName>& indexedTags = m_IndexedTags.FindOrAdd(Actor);
+	for (const FName& tag : Actor->Tags)
+	{
+		if (!indexedTags.Contains(tag))
+		{
+			indexedTags.Add(tag);
+			m_TagToActors.FindOrAdd(tag).Add(Actor);
+		}
+	}
+}
+
+void USDTTagRegistrySubsystem::RemoveActor(AActor* Actor)
+{
+	TArray<FName> indexedTags;
+	if (!m_IndexedTags.RemoveAndCopyValue(Actor, indexedTags))
+	{
+		return;
+	}
+
+	for (const FName& tag : indexedTags)
+	{
+		if (TArray<TWeakObjectPtr<AActor>>* actors = m_TagToActors.Find(tag))
+		{
+			// Keep the registration order so FindFirstActorWithTag stays stable
+			actors->RemoveSingle(Actor);
+			if (actors->IsEmpty())
+			{
+				m_TagToActors.Remove(tag);
+			}
+		}
+	}
+
+	++m_TagsGeneration;
+}
+
+void USDTTagRegistrySubsystem::NotifyTagsChanged(AActor* Actor)
+{
+	RemoveActor(Actor);
+	AddActor(Actor);
+}
+
+AActor* USDTTagRegistrySubsystem::FindFirstActorWithTag(FName Tag) const
+{
+	if (const TArray<TWeakObjectPtr<AActor>>* actors = m_TagToActors.Find(Tag))
+	{
+		for (const TWeakObjectPtr<AActor>& actor : *actors)
+		{
+			if (actor.IsValid())
+			{
+				return actor.Get();
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void USDTTagRegistrySubsystem::GetActorsWithTag(FName Tag, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+
+	if (const TArray<TWeakObjectPtr<AActor>>* actors = m_TagToActors.Find(Tag))
+	{
+		for (const TWeakObjectPtr<AActor>& actor : *actors)
+		{
+			if (actor.IsValid())
+			{
+				OutActors.Add(actor.Get());
+			}
+		}
+	}
+}
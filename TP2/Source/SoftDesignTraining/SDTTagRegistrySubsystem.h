@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTTagRegistrySubsystem.generated.h"
+
+/**
+ * Tag -> actors index for the world, replacing UGameplayStatics::GetAllActorsWithTag scans.
+ * Filled from the actors present at BeginPlay, then kept up to date by the world's spawn and destroy
+ * handlers. Tags have no change event in the engine: code that edits AActor::Tags at runtime must
+ * call NotifyTagsChanged.
+ */
+UCLASS()
+class SOFTDESIGNTRAINING_API USDTTagRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// First registered actor with the tag (same order as a world actor scan), nullptr if none
+	AActor* FindFirstActorWithTag(FName Tag) const;
+	void GetActorsWithTag(FName Tag, TArray<AActor*>& OutActors) const;
+
+	// Re-indexes an actor after its Tags array was modified
+	void NotifyTagsChanged(AActor* Actor);
+
+	// Incremented when an indexed actor loses a tag, so callers can drop cached lookups
+	uint32 GetTagsGeneration() const { return m_TagsGeneration; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+
+	TMap<FName, TArray<TWeakObjectPtr<AActor>>> m_TagToActors;
+
+	// Tags each actor was indexed with, to unindex it even if its Tags array changed since
+	TMap<TWeakObjectPtr<AActor>, TArray<FName>> m_IndexedTags;
+
+	uint32 m_TagsGeneration = 0;
+
+	FDelegateHandle m_ActorSpawnedHandle;
+	FDelegateHandle m_ActorDestroyedHandle;
+};
@@ -4,16 +4,40 @@
 #include "SoftDesignTraining.h"
 #include "SoftDesignTrainingPlayerController.h"
 #include "SoftDesignTrainingCharacter.h"
+#include "Engine/AssetManager.h"
 
 ASoftDesignTrainingGameMode::ASoftDesignTrainingGameMode()
 {
 	// use our custom PlayerController class
 	PlayerControllerClass = ASoftDesignTrainingPlayerController::StaticClass();
 
-	// set default pawn class to our Blueprinted character
-	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/Blueprint/BP_SDTMainCharacter"));
-	if (PlayerPawnBPClass.Class != NULL)
+	// set default pawn class to our Blueprinted character (loaded asynchronously in InitGame)
+	m_PlayerPawnClass = TSoftClassPtr<APawn>(FSoftObjectPath(TEXT("/Game/Blueprint/BP_SDTMainCharacter.BP_SDTMainCharacter_C")));
+}
+
+void ASoftDesignTrainingGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	// Preload while the map loads so the first spawn does not block on a synchronous load.
+	// AI pawn classes are soft references on the spawners, loaded by USDTSpawnSchedulerSubsystem::RequestPreload.
+	if (!m_PlayerPawnClass.IsNull())
+	{
+		m_PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(m_PlayerPawnClass.ToSoftObjectPath(), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+}
+
+UClass* ASoftDesignTrainingGameMode::GetDefaultPawnClassForController_Implementation(AController* InController)
+{
+	if (m_PlayerPawnClass.IsNull())
+	{
+		return Super::GetDefaultPawnClassForController_Implementation(InController);
+	}
+
+	// Normally resident already; otherwise finish the load here
+	if (UClass* pawnClass = m_PlayerPawnClass.Get())
 	{
-		DefaultPawnClass = PlayerPawnBPClass.Class;
+		return pawnClass;
 	}
-}
\ No newline at end of file
+	return m_PlayerPawnClass.LoadSynchronous();
+}
@@ -1,6 +1,7 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 #pragma once
 #include "GameFramework/GameMode.h"
+#include "Engine/StreamableManager.h"
 #include "SoftDesignTrainingGameMode.generated.h"
 
 UCLASS(minimalapi)
@@ -10,6 +11,17 @@ class ASoftDesignTrainingGameMode : public AGameMode
 
 public:
 	ASoftDesignTrainingGameMode();
+
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
+
+private:
+	// Player pawn as a soft reference, preloaded in InitGame instead of at construction
+	UPROPERTY(EditDefaultsOnly, Category = Classes)
+	TSoftClassPtr<APawn> m_PlayerPawnClass;
+
+	// Keeps the preloaded assets resident for the whole match
+	TSharedPtr<FStreamableHandle> m_PreloadHandle;
 };
 
 
@@ -9,6 +9,8 @@
 #include "DrawDebugHelpers.h"
 #include "NavigationPath.h"
 #include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
 #include "Blueprint/AIBlueprintHelperLibrary.h"
 #include "SDTBridge.h"
 #include "SDTBoatOperator.h"
@@ -94,20 +96,44 @@ void ASoftDesignTrainingPlayerController::MoveCharacter()
     GetHitResultUnderCursor(ECC_Visibility, false, Hit);
     if (!Hit.bBlockingHit) return;
 
-    UNavigationPath* path = UNavigationSystemV1::FindPathToLocationSynchronously(
-        this,
-        GetPawn()->GetActorLocation(),
-        Hit.ImpactPoint
+    APawn* pawn = GetPawn();
+    UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    if (pawn == nullptr || navSys == nullptr) return;
+
+    const ANavigationData* navData = navSys->GetNavDataForProps(pawn->GetNavAgentPropertiesRef(), pawn->GetNavAgentLocation());
+    if (navData == nullptr) return;
+
+    // Only the latest click matters
+    if (m_PendingPathQueryId != INVALID_NAVQUERYID)
+    {
+        navSys->AbortAsyncFindPathRequest(m_PendingPathQueryId);
+    }
+
+    FPathFindingQuery query(this, *navData, pawn->GetActorLocation(), Hit.ImpactPoint, UNavigationQueryFilter::GetQueryFilter(*navData, this, nullptr));
+    m_PendingMoveGoal = Hit.ImpactPoint;
+    m_PendingPathQueryId = navSys->FindPathAsync(
+        pawn->GetNavAgentPropertiesRef(),
+        query,
+        FNavPathQueryDelegate::CreateUObject(this, &ASoftDesignTrainingPlayerController::OnMovePathFound)
         );
-    
-    if(!path || !path->GetPath().IsValid() ||
-        path->GetPath()->IsPartial() ||
-        path->GetPath()->GetPathPoints().Num() == 0)
+}
+
+void ASoftDesignTrainingPlayerController::OnMovePathFound(uint32 queryId, ENavigationQueryResult::Type result, FNavPathSharedPtr path)
+{
+    // Result of a request superseded by a newer click
+    if (queryId != m_PendingPathQueryId) return;
+    m_PendingPathQueryId = INVALID_NAVQUERYID;
+
+    if (not m_CanMoveCharacter) return;
+
+    if (result != ENavigationQueryResult::Success ||
+        !path.IsValid() ||
+        path->IsPartial())
     {
         return;
     }
 
-    TArray<FNavPathPoint> points = path->GetPath()->GetPathPoints();
+    const TArray<FNavPathPoint>& points = path->GetPathPoints();
     if (points.Num() < 2) return;
 
     for (int32 i = 0; i < points.Num(); i++)
@@ -137,8 +163,8 @@ void ASoftDesignTrainingPlayerController::MoveCharacter()
             );
     }
     
-    FAIMoveRequest MoveRequest(Hit.ImpactPoint);
-    m_PathFollowingComponent->RequestMove(MoveRequest, path->GetPath());
+    FAIMoveRequest MoveRequest(m_PendingMoveGoal);
+    m_PathFollowingComponent->RequestMove(MoveRequest, path);
 }
 
 void ASoftDesignTrainingPlayerController::Activate()
@@ -26,6 +26,7 @@ protected:
     void ZoomCamera(float axisValue);
 
     void MoveCharacter();
+    void OnMovePathFound(uint32 queryId, ENavigationQueryResult::Type result, FNavPathSharedPtr path);
 
     void Activate();
     void Deactivate();
@@ -36,6 +37,10 @@ protected:
 
     bool m_CanMoveCharacter;
 
+    // Click-to-move path query in flight, aborted when a newer click supersedes it
+    uint32 m_PendingPathQueryId = INVALID_NAVQUERYID;
+    FVector m_PendingMoveGoal = FVector::ZeroVector;
+
     ASDTBridge* m_BridgeActivated;
     ASDTBoatOperator* m_BoatOperatorActivated;
 };
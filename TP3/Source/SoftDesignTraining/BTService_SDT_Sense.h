@@ -17,6 +17,9 @@
  * Stratégie pour Decorators "Is Set":
  * - HasLOS / IsPlayerPoweredUp: SetValueAsBool(true/false). "Is Set" sera vrai si true, faux si false.
  * - LKP: écrit quand LOS vrai, laisse expirer via LKPValidUntil.
+ *
+ * Le service ne fait que déposer une requête: la perception et les écritures sont faites en lot
+ * par USDTSenseSubsystem (décision en parallèle, application sur le game thread).
  */
 UCLASS()
 class SOFTDESIGNTRAINING_API UBTService_SDT_Sense : public UBTService
@@ -26,7 +29,10 @@ class SOFTDESIGNTRAINING_API UBTService_SDT_Sense : public UBTService
 public:
 	UBTService_SDT_Sense();
 
+	virtual uint16 GetInstanceMemorySize() const override;
+
 protected:
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 
 	// Durée de validité de la LKP après perte de vue (aligné sur l'ancienne logique: 3s)
@@ -42,23 +48,11 @@ protected:
 	bool bDrawDebug = false;
 
 private:
-	// Helpers Blackboard
-	static const FName KEY_PlayerActor;
-	static const FName KEY_HasLOS;
-	static const FName KEY_IsPlayerPoweredUp;
-	static const FName KEY_LKP;
-	static const FName KEY_LKPValidUntil;
-	static const FName KEY_TargetLocation;
-
-	// Perception de base
-	bool ComputeLOS(UWorld* World, const FVector& From, const FVector& To) const;
-
-	// Choix d'une TargetLocation pour Flee (reprend l'idée du score existant)
-	bool ChooseBestFleeLocation(UWorld* World, const FVector& SelfLocation, FVector& OutLocation) const;
-
-	// Choix d'une TargetLocation pour Collect (non cooldown)
-	bool ChooseCollectible(UWorld* World, FVector& OutLocation) const;
-
-	// Temps courant monde
-	static float Now(const UWorld* World);
+	// État par agent dans la mémoire du BT: le service reste un seul UObject partagé
+	struct FSenseMemory
+	{
+		float DetectionHalfLength;
+		float DetectionRadius;
+		float DetectionForwardOffset;
+	};
 };
@@ -0,0 +1,93 @@
+#include "BTTask_SDT_FollowFlowField.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "AIController.h"
+#include "GameFramework/Pawn.h"
+
+#include "SDTFlowFieldSubsystem.h"
+
+UBTTask_SDT_FollowFlowField::UBTTask_SDT_FollowFlowField()
+{
+	NodeName = TEXT("SDT Follow Flow Field");
+	bNotifyTick = true;
+	bNotifyTaskFinished = true;
+}
+
+uint16 UBTTask_SDT_FollowFlowField::GetInstanceMemorySize() const
+{
+	return sizeof(FFollowFlowFieldMemory);
+}
+
+EBTNodeResult::Type UBTTask_SDT_FollowFlowField::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	AAIController* AICon = OwnerComp.GetAIOwner();
+	if (!AICon || !AICon->GetPawn())
+		return EBTNodeResult::Failed;
+
+	FFollowFlowFieldMemory* Memory = CastInstanceNodeMemory<FFollowFlowFieldMemory>(NodeMemory);
+	Memory->bIsConsumer = false;
+
+	USDTFlowFieldSubsystem* FlowField = AICon->GetWorld()->GetSubsystem<USDTFlowFieldSubsystem>();
+	if (!FlowField || !FlowField->HasGoal())
+		return EBTNodeResult::Failed;
+
+	// Le champ n'est maintenu que tant qu'une tâche le lit
+	FlowField->AddConsumer();
+	Memory->bIsConsumer = true;
+
+	// Le champ remplace la requête de chemin: on coupe tout Move To en cours
+	AICon->StopMovement();
+
+	Memory->ElapsedTime = 0.f;
+	return EBTNodeResult::InProgress;
+}
+
+void UBTTask_SDT_FollowFlowField::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	AAIController* AICon = OwnerComp.GetAIOwner();
+	APawn* SelfPawn = AICon ? AICon->GetPawn() : nullptr;
+	const USDTFlowFieldSubsystem* FlowField = SelfPawn ? SelfPawn->GetWorld()->GetSubsystem<USDTFlowFieldSubsystem>() : nullptr;
+
+	if (!FlowField)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	const FVector SelfLoc = SelfPawn->GetActorLocation();
+	if (FVector::Dist2D(SelfLoc, FlowField->GetGoalLocation()) <= AcceptanceRadius)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	FVector Direction;
+	if (!FlowField->GetFlowDirection(SelfLoc, Direction))
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	SelfPawn->AddMovementInput(Direction);
+
+	FFollowFlowFieldMemory* Memory = CastInstanceNodeMemory<FFollowFlowFieldMemory>(NodeMemory);
+	Memory->ElapsedTime += DeltaSeconds;
+	if (MaxDuration > 0.f && Memory->ElapsedTime >= MaxDuration)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+	}
+}
+
+void UBTTask_SDT_FollowFlowField::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	FFollowFlowFieldMemory* Memory = CastInstanceNodeMemory<FFollowFlowFieldMemory>(NodeMemory);
+	if (Memory->bIsConsumer)
+	{
+		if (USDTFlowFieldSubsystem* FlowField = OwnerComp.GetWorld()->GetSubsystem<USDTFlowFieldSubsystem>())
+		{
+			FlowField->RemoveConsumer();
+		}
+		Memory->bIsConsumer = false;
+	}
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BTTask_SDT_FollowFlowField.generated.h"
+
+/**
+ * Poursuite par champ de flux: l'agent suit la direction lue dans USDTFlowFieldSubsystem
+ * au lieu de lancer sa propre requête de chemin vers le joueur.
+ * Variante sans chemin: la branche Chase du BT livré lit déjà le champ via son Move To
+ * (voir USDTPathFollowingComponent::MakeFlowFieldPath); cette tâche sert aux arbres qui veulent un
+ * pilotage direct par la direction du champ.
+ * Réussit quand la cible est atteinte (ou après MaxDuration pour laisser le BT réévaluer),
+ * échoue si l'agent est hors du champ (le BT peut alors retomber sur un Move To classique).
+ * Tant que la tâche est active, elle garde le champ calculé (voir USDTFlowFieldSubsystem::AddConsumer).
+ */
+UCLASS()
+class SOFTDESIGNTRAINING_API UBTTask_SDT_FollowFlowField : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_SDT_FollowFlowField();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+
+protected:
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+
+	UPROPERTY(EditAnywhere, Category = "SDT|FlowField")
+	float AcceptanceRadius = 100.f;
+
+	// Durée max avant de rendre la main au BT (0 : illimité)
+	UPROPERTY(EditAnywhere, Category = "SDT|FlowField")
+	float MaxDuration = 1.f;
+
+private:
+	struct FFollowFlowFieldMemory
+	{
+		float ElapsedTime;
+		bool bIsConsumer;
+	};
+};
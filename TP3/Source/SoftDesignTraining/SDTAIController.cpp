@@ -9,37 +9,25 @@
 #include "Kismet/KismetMathLibrary.h"
 //#include "UnrealMathUtility.h"
 #include "SDTUtils.h"
+#include "SDTVisibilitySubsystem.h"
+#include "SDTHierarchicalPathSubsystem.h"
 #include "EngineUtils.h"
 #include "SoftDesignTrainingGameMode.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BlackboardData.h"
-#include "UObject/ConstructorHelpers.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 
 ASDTAIController::ASDTAIController(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer.SetDefaultSubobjectClass<USDTPathFollowingComponent>(TEXT("PathFollowingComponent")))
 {
     m_PlayerInteractionBehavior = PlayerInteractionBehavior_Collect;
 
-    // Charger automatiquement le BT/BB si non assignés dans l’éditeur (chemins selon tes assets)
+    // Chemins par défaut si non assignés dans l’éditeur (aucun chargement ici)
     // Modifie ces chemins si tu as placé les assets ailleurs.
-    if (!BehaviorTreeAsset)
-    {
-        static ConstructorHelpers::FObjectFinder<UBehaviorTree> BTObj(TEXT("/Game/StarterContent/ArtificialIntelligence/BT_SDT_AI.BT_SDT_AI"));
-        if (BTObj.Succeeded())
-        {
-            BehaviorTreeAsset = BTObj.Object;
-        }
-    }
-
-    if (!BlackboardAsset)
-    {
-        static ConstructorHelpers::FObjectFinder<UBlackboardData> BBObj(TEXT("/Game/StarterContent/ArtificialIntelligence/BB_SDT_AI.BB_SDT_AI"));
-        if (BBObj.Succeeded())
-        {
-            BlackboardAsset = BBObj.Object;
-        }
-    }
+    BehaviorTreeAsset = TSoftObjectPtr<UBehaviorTree>(FSoftObjectPath(TEXT("/Game/StarterContent/ArtificialIntelligence/BT_SDT_AI.BT_SDT_AI")));
+    BlackboardAsset = TSoftObjectPtr<UBlackboardData>(FSoftObjectPath(TEXT("/Game/StarterContent/ArtificialIntelligence/BB_SDT_AI.BB_SDT_AI")));
 }
 
 void ASDTAIController::OnPossess(APawn* InPawn)
@@ -51,21 +39,55 @@ void ASDTAIController::OnPossess(APawn* InPawn)
         return;
     }
 
+    // Normalement déjà résidents grâce au préchargement du GameMode
+    const bool btPending = !BehaviorTreeAsset.IsNull() && !BehaviorTreeAsset.IsValid();
+    const bool bbPending = !BlackboardAsset.IsNull() && !BlackboardAsset.IsValid();
+    if (!btPending && !bbPending)
+    {
+        StartBehaviorTree();
+        return;
+    }
+
+    // Sinon on charge en asynchrone plutôt que de bloquer le thread de jeu
+    TArray<FSoftObjectPath> assets;
+    if (btPending)
+    {
+        assets.Add(BehaviorTreeAsset.ToSoftObjectPath());
+    }
+    if (bbPending)
+    {
+        assets.Add(BlackboardAsset.ToSoftObjectPath());
+    }
+
+    UAssetManager::GetStreamableManager().RequestAsyncLoad(assets, FStreamableDelegate::CreateUObject(this, &ASDTAIController::OnBehaviorAssetsLoaded));
+}
+
+void ASDTAIController::OnBehaviorAssetsLoaded()
+{
+    // Le pawn peut avoir été détruit ou dépossédé pendant le chargement
+    if (GetPawn() && bUseBehaviorTree)
+    {
+        StartBehaviorTree();
+    }
+}
+
+void ASDTAIController::StartBehaviorTree()
+{
     // Initialiser le Blackboard et lancer le BT
-    if (BlackboardAsset)
+    if (UBlackboardData* blackboard = BlackboardAsset.Get())
     {
-        UseBlackboard(BlackboardAsset, BlackboardComp);
+        UseBlackboard(blackboard, BlackboardComp);
     }
 
-    if (BehaviorTreeAsset)
+    if (UBehaviorTree* behaviorTree = BehaviorTreeAsset.Get())
     {
-        RunBehaviorTree(BehaviorTreeAsset);
+        RunBehaviorTree(behaviorTree);
     }
 
     // Ecrire SelfActor dans le Blackboard (utile pour certains BT/Tasks)
-    if (BlackboardComp && InPawn)
+    if (BlackboardComp && GetPawn())
     {
-        BlackboardComp->SetValueAsObject(TEXT("SelfActor"), InPawn);
+        BlackboardComp->SetValueAsObject(TEXT("SelfActor"), GetPawn());
     }
 }
 
@@ -150,6 +172,7 @@ void ASDTAIController::PlayerInteractionLoSUpdate()
     GetWorld()->LineTraceSingleByObjectType(losHit, GetPawn()->GetActorLocation(), playerCharacter->GetActorLocation(), TraceObjectTypes);
 
     bool hasLosOnPlayer = false;
+    USDTCooldownSubsystem* cooldowns = GetWorld()->GetSubsystem<USDTCooldownSubsystem>();
 
     if (losHit.GetComponent())
     {
@@ -161,18 +184,17 @@ void ASDTAIController::PlayerInteractionLoSUpdate()
 
     if (hasLosOnPlayer)
     {
-        if (GetWorld()->GetTimerManager().IsTimerActive(m_PlayerInteractionNoLosTimer))
+        if (cooldowns && cooldowns->IsActive(m_PlayerInteractionNoLosTimer))
         {
-            GetWorld()->GetTimerManager().ClearTimer(m_PlayerInteractionNoLosTimer);
-            m_PlayerInteractionNoLosTimer.Invalidate();
+            cooldowns->Cancel(m_PlayerInteractionNoLosTimer);
             DrawDebugString(GetWorld(), FVector(0.f, 0.f, 10.f), "Got LoS", GetPawn(), FColor::Red, 5.f, false);
         }
     }
     else
     {
-        if (!GetWorld()->GetTimerManager().IsTimerActive(m_PlayerInteractionNoLosTimer))
+        if (cooldowns && !cooldowns->IsActive(m_PlayerInteractionNoLosTimer))
         {
-            GetWorld()->GetTimerManager().SetTimer(m_PlayerInteractionNoLosTimer, this, &ASDTAIController::OnPlayerInteractionNoLosDone, 3.f, false);
+            m_PlayerInteractionNoLosTimer = cooldowns->Start(3.f, FSimpleDelegate::CreateUObject(this, &ASDTAIController::OnPlayerInteractionNoLosDone));
             DrawDebugString(GetWorld(), FVector(0.f, 0.f, 10.f), "Lost LoS", GetPawn(), FColor::Red, 5.f, false);
         }
     }
@@ -181,7 +203,7 @@ void ASDTAIController::PlayerInteractionLoSUpdate()
 
 void ASDTAIController::OnPlayerInteractionNoLosDone()
 {
-    GetWorld()->GetTimerManager().ClearTimer(m_PlayerInteractionNoLosTimer);
+    m_PlayerInteractionNoLosTimer.Invalidate();
     DrawDebugString(GetWorld(), FVector(0.f, 0.f, 10.f), "TIMER DONE", GetPawn(), FColor::Red, 5.f, false);
 
     if (!AtJumpSegment)
@@ -263,6 +285,57 @@ void ASDTAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollow
     m_ReachedTarget = true;
 }
 
+void ASDTAIController::FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const
+{
+    // Move To sur le joueur (branche Chase): chemin lu dans le champ de flux partagé, sans requête A* par agent
+    if (MoveRequest.IsMoveToActorRequest())
+    {
+        USDTPathFollowingComponent* pathFollowing = Cast<USDTPathFollowingComponent>(GetPathFollowingComponent());
+        if (!pathFollowing || !pathFollowing->MakeFlowFieldPath(MoveRequest, Query, OutPath))
+        {
+            Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+        }
+        return;
+    }
+
+    USDTHierarchicalPathSubsystem* hierarchicalPath = GetWorld()->GetSubsystem<USDTHierarchicalPathSubsystem>();
+
+    TArray<FVector> waypoints;
+    if (!hierarchicalPath || !hierarchicalPath->FindAbstractPath(Query.StartLocation, Query.EndLocation, waypoints))
+    {
+        Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+        return;
+    }
+
+    // Seul le premier tronçon (jusqu'au premier portail) est calculé en détail
+    FPathFindingQuery firstLegQuery(Query);
+    firstLegQuery.EndLocation = waypoints[0];
+    Super::FindPathForMoveRequest(MoveRequest, firstLegQuery, OutPath);
+
+    if (!OutPath.IsValid())
+    {
+        Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+        return;
+    }
+
+    // Les portails suivants sont raffinés par USDTPathFollowingComponent à l'approche
+    TArray<FNavPathPoint>& pathPoints = OutPath->GetPathPoints();
+    for (int32 i = 1; i < waypoints.Num(); ++i)
+    {
+        pathPoints.Add(SDTUtils::MakeHierarchicalPortalPoint(waypoints[i]));
+    }
+
+    // Un repath doit viser la vraie destination, pas le premier portail
+    OutPath->SetQueryData(Query);
+}
+
+bool ASDTAIController::HasPendingWork() const
+{
+    // BT ONLY: UpdatePlayerInteraction et GoToBestTarget sont vides. Reste l'affichage du chemin
+    // pendant un déplacement (la rotation de contrôle est mise à jour pour tous par le tick manager).
+    return !m_ReachedTarget;
+}
+
 void ASDTAIController::ShowNavigationPath()
 {
     if (UPathFollowingComponent* pathFollowingComponent = GetPathFollowingComponent())
@@ -290,7 +363,7 @@ void ASDTAIController::UpdatePlayerInteraction(float deltaTime)
     // BT ONLY: toute la logique legacy de détection/état est commentée pour garantir que le BT commande.
     /*
     // Si le Behavior Tree pilote, on ignore la logique legacy
-    if (bUseBehaviorTree && BehaviorTreeAsset)
+    if (bUseBehaviorTree && !BehaviorTreeAsset.IsNull())
         return;
 
     //finish jump before updating AI state
@@ -361,6 +434,14 @@ bool ASDTAIController::HasLoSOnHit(const FHitResult& hit)
     if (!hit.GetComponent())
         return false;
 
+    if (const USDTVisibilitySubsystem* visibility = GetWorld()->GetSubsystem<USDTVisibilitySubsystem>())
+    {
+        // Paire prouvée par le bake; Unknown passe par le vrai trace
+        const ESDTVisibility baked = visibility->QueryVisibility(hit.TraceStart, hit.ImpactPoint);
+        if (baked != ESDTVisibility::Unknown)
+            return baked == ESDTVisibility::Visible;
+    }
+
     TArray<TEnumAsByte<EObjectTypeQuery>> TraceObjectTypes;
     TraceObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_WorldStatic));
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "SDTBaseAIController.h"
+#include "SDTCooldownSubsystem.h"
 #include "SDTAIController.generated.h"
 
 /**
@@ -18,11 +19,12 @@ public:
     ASDTAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
     // Behavior Tree (assigner dans l’éditeur)
+    // Références souples: préchargées par le GameMode, chargées en asynchrone au besoin
     UPROPERTY(EditDefaultsOnly, Category = AI)
-    class UBehaviorTree* BehaviorTreeAsset;
+    TSoftObjectPtr<class UBehaviorTree> BehaviorTreeAsset;
 
     UPROPERTY(EditDefaultsOnly, Category = AI)
-    class UBlackboardData* BlackboardAsset;
+    TSoftObjectPtr<class UBlackboardData> BlackboardAsset;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = AI)
     class UBlackboardComponent* BlackboardComp;
@@ -82,6 +84,7 @@ protected:
 
 public:
     virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+    virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const override;
     void RotateTowards(const FVector& targetLocation);
     void SetActorLocation(const FVector& targetLocation);
     void AIStateInterrupted();
@@ -90,11 +93,16 @@ private:
     virtual void GoToBestTarget(float deltaTime) override;
     virtual void UpdatePlayerInteraction(float deltaTime) override;
     virtual void ShowNavigationPath() override;
+    virtual bool HasPendingWork() const override;
+
+    // Lance le BT une fois les assets résidents
+    void StartBehaviorTree();
+    void OnBehaviorAssetsLoaded();
 
 
 protected:
     FVector m_JumpTarget;
     FRotator m_ObstacleAvoidanceRotation;
-    FTimerHandle m_PlayerInteractionNoLosTimer;
+    FSDTCooldownHandle m_PlayerInteractionNoLosTimer;
     PlayerInteractionBehavior m_PlayerInteractionBehavior;
 };
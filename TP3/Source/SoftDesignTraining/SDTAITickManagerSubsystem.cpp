@@ -0,0 +1,88 @@
+#include "SDTAITickManagerSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "SDTBaseAIController.h"
+#include "Async/ParallelFor.h"
+
+void USDTAITickManagerSubsystem::Deinitialize()
+{
+	for (ASDTBaseAIController* Controller : m_Controllers)
+	{
+		Controller->m_TickManagerIndex = INDEX_NONE;
+	}
+
+	m_Controllers.Empty();
+	m_PendingWork.Empty();
+	m_ToUpdate.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTAITickManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTAITickManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTAITickManagerSubsystem, STATGROUP_Tickables);
+}
+
+void USDTAITickManagerSubsystem::RegisterController(ASDTBaseAIController* Controller)
+{
+	if (Controller == nullptr || Controller->m_TickManagerIndex != INDEX_NONE)
+		return;
+
+	Controller->m_TickManagerIndex = m_Controllers.Add(Controller);
+}
+
+void USDTAITickManagerSubsystem::UnregisterController(ASDTBaseAIController* Controller)
+{
+	const int32 Index = Controller ? Controller->m_TickManagerIndex : INDEX_NONE;
+	if (!m_Controllers.IsValidIndex(Index) || m_Controllers[Index] != Controller)
+		return;
+
+	m_Controllers.RemoveAtSwap(Index);
+	if (m_Controllers.IsValidIndex(Index))
+	{
+		m_Controllers[Index]->m_TickManagerIndex = Index;
+	}
+	Controller->m_TickManagerIndex = INDEX_NONE;
+}
+
+void USDTAITickManagerSubsystem::Tick(float DeltaTime)
+{
+	const int32 Count = m_Controllers.Num();
+	if (Count == 0)
+		return;
+
+	m_PendingWork.SetNumUninitialized(Count);
+
+	ASDTBaseAIController* const* Controllers = m_Controllers.GetData();
+	uint8* PendingWork = m_PendingWork.GetData();
+
+	ParallelFor(Count, [Controllers, PendingWork](int32 Index)
+	{
+		PendingWork[Index] = Controllers[Index]->HasPendingWork() ? 1 : 0;
+	}, !bParallelDecision || Count < MinParallelControllers);
+
+	// Ce que fait AAIController::Tick, pour tout le monde: c'est aussi ce qui recopie l'orientation du
+	// pawn dans la rotation de contrôle, lue dès qu'un segment de saut utilise la rotation du contrôleur
+	m_ToUpdate.Reset();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Controllers[Index]->UpdateControlRotation(DeltaTime);
+
+		if (PendingWork[Index])
+		{
+			m_ToUpdate.Add(Controllers[Index]);
+		}
+	}
+
+	// Mises à jour sur le game thread; un contrôleur peut en retirer un autre (EndPlay) pendant le parcours
+	for (const TWeakObjectPtr<ASDTBaseAIController>& Controller : m_ToUpdate)
+	{
+		if (Controller.IsValid() && Controller->m_TickManagerIndex != INDEX_NONE)
+		{
+			Controller->UpdateAgent(DeltaTime);
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTAITickManagerSubsystem.generated.h"
+
+class ASDTBaseAIController;
+
+/**
+ * Tick unique pour tous les ASDTBaseAIController à la place d'un tick d'acteur par contrôleur.
+ * Les contrôleurs sont rangés dans un tableau contigu (index conservé sur le contrôleur, retrait par
+ * échange avec le dernier). Chaque frame, une étape de décision en lecture seule (HasPendingWork)
+ * marque les contrôleurs qui ont quelque chose à faire, éventuellement en parallèle, puis seuls
+ * ceux-là sont mis à jour sur le game thread. La rotation de contrôle, peu coûteuse, est mise à jour
+ * pour tous les contrôleurs comme le ferait AAIController::Tick.
+ *
+ * Avec le BT aux commandes, la logique legacy est vide: un contrôleur sans focus ni chemin à
+ * afficher ne coûte plus qu'un test et sa rotation de contrôle par frame.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTAITickManagerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterController(ASDTBaseAIController* Controller);
+	void UnregisterController(ASDTBaseAIController* Controller);
+
+	int32 GetNumControllers() const { return m_Controllers.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Étape de décision en ParallelFor (HasPendingWork ne doit que lire l'état du contrôleur)
+	UPROPERTY(Config)
+	bool bParallelDecision = true;
+
+	// En dessous, la décision reste sur le game thread
+	UPROPERTY(Config)
+	int32 MinParallelControllers = 64;
+
+private:
+	// Retirés dans EndPlay: jamais de pointeur pendant
+	TArray<ASDTBaseAIController*> m_Controllers;
+
+	// Un octet par contrôleur (pas de bits partagés entre threads)
+	TArray<uint8> m_PendingWork;
+	TArray<TWeakObjectPtr<ASDTBaseAIController>> m_ToUpdate;
+};
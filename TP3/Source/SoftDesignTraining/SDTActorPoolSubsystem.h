@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/Interface.h"
+#include "SDTActorPoolSubsystem.generated.h"
+
+UINTERFACE(MinimalAPI)
+class USDTPoolable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implémentée par les acteurs poolés (et leurs contrôleurs) qui doivent réinitialiser leur état.
+ */
+class SOFTDESIGNTRAINING_API ISDTPoolable
+{
+	GENERATED_BODY()
+
+public:
+	// Appelée après la réactivation de l'acteur, déjà placé à son nouveau transform
+	virtual void OnAcquiredFromPool() {}
+
+	// Appelée avant la désactivation de l'acteur et son retour au pool
+	virtual void OnReleasedToPool() {}
+};
+
+USTRUCT()
+struct FSDTActorPoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> Actors;
+};
+
+/**
+ * Pool d'acteurs du monde. Un acteur relâché est masqué, sans collision et sans tick au lieu d'être
+ * détruit: en régime permanent, apparitions et disparitions n'allouent plus et ne chargent plus le GC.
+ * Les pawns sont poolés avec leur contrôleur IA, qui reste possédé pendant qu'ils sont au pool.
+ */
+UCLASS()
+class SOFTDESIGNTRAINING_API USDTActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Crée Count acteurs inactifs de Class (avec leur contrôleur par défaut pour les pawns)
+	void Prewarm(TSubclassOf<AActor> Class, int32 Count, const FTransform& Transform);
+
+	// Retourne un acteur du pool, ou en crée un si le pool est vide
+	AActor* Acquire(TSubclassOf<AActor> Class, const FTransform& Transform);
+
+	template <typename T>
+	T* Acquire(TSubclassOf<AActor> Class, const FTransform& Transform) { return Cast<T>(Acquire(Class, Transform)); }
+
+	// Désactive l'acteur (et son contrôleur pour un pawn) et le remet dans le pool de sa classe
+	void Release(AActor* Actor);
+
+	int32 GetNumFree(TSubclassOf<AActor> Class) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	AActor* SpawnPooledActor(UClass* Class, const FTransform& Transform);
+	void DeactivateActor(AActor* Actor);
+	void ActivateActor(AActor* Actor);
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FSDTActorPoolList> m_FreeActors;
+
+	// Acteurs et composants qui tickaient au moment du relâchement, réactivés à l'acquisition
+	TSet<TWeakObjectPtr<AActor>> m_SuspendedActors;
+	TMap<TWeakObjectPtr<AActor>, TArray<TWeakObjectPtr<UActorComponent>>> m_SuspendedComponents;
+};
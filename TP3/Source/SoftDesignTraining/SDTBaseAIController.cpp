@@ -2,6 +2,7 @@
 
 #include "SDTBaseAIController.h"
 #include "SoftDesignTraining.h"
+#include "SDTAITickManagerSubsystem.h"
 
 ASDTBaseAIController::ASDTBaseAIController(const FObjectInitializer& ObjectInitializer)
     :Super(ObjectInitializer)
@@ -11,10 +12,37 @@ ASDTBaseAIController::ASDTBaseAIController(const FObjectInitializer& ObjectIniti
     m_ReachedTarget = true;
 }
 
+void ASDTBaseAIController::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Plus de tick d'acteur: le tick manager visite les contrôleurs qui ont du travail
+    if (USDTAITickManagerSubsystem* tickManager = GetWorld()->GetSubsystem<USDTAITickManagerSubsystem>())
+    {
+        tickManager->RegisterController(this);
+        SetActorTickEnabled(false);
+    }
+}
+
+void ASDTBaseAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USDTAITickManagerSubsystem* tickManager = GetWorld()->GetSubsystem<USDTAITickManagerSubsystem>())
+    {
+        tickManager->UnregisterController(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ASDTBaseAIController::Tick(float deltaTime)
 {
     Super::Tick(deltaTime);
 
+    UpdateAgent(deltaTime);
+}
+
+void ASDTBaseAIController::UpdateAgent(float deltaTime)
+{
     UpdatePlayerInteraction(deltaTime);
 
     if (m_ReachedTarget)
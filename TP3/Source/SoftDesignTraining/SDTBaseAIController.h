@@ -14,17 +14,30 @@ class SOFTDESIGNTRAINING_API ASDTBaseAIController : public AAIController
 {
 	GENERATED_BODY()
 
+    friend class USDTAITickManagerSubsystem;
+
 public:
 
     ASDTBaseAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    // Utilisé seulement sans USDTAITickManagerSubsystem
     virtual void Tick(float deltaTime) override;
 	
 protected:
+    // Étape de décision du tick manager, possiblement hors game thread: lecture seule
+    virtual bool HasPendingWork() const { return true; }
+
     virtual void RotationUpdate(float deltaTime) {};
     virtual void ImpulseToDirection(float deltaTime) {};
 
     bool m_ReachedTarget;
 private:
+    // Corps du tick, appelé par le tick manager quand HasPendingWork est vrai
+    void UpdateAgent(float deltaTime);
+
+    int32 m_TickManagerIndex = INDEX_NONE;
+
     virtual void GoToBestTarget(float deltaTime) {};
     virtual void UpdatePlayerInteraction(float deltaTime) {};
     virtual void ShowNavigationPath() {};
@@ -0,0 +1,51 @@
+#include "SDTCapsuleHash.h"
+#include "SoftDesignTraining.h"
+#include "Components/CapsuleComponent.h"
+
+void FSDTCapsuleHash::Reset(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 1.f);
+	Bottoms.Reset();
+	Tops.Reset();
+	Radii.Reset();
+	Cells.Reset();
+}
+
+int32 FSDTCapsuleHash::Add(const UCapsuleComponent& Capsule)
+{
+	const FVector Center = Capsule.GetComponentLocation();
+	const float Radius = Capsule.GetScaledCapsuleRadius();
+	const FVector AxisOffset(0.f, 0.f, Capsule.GetScaledCapsuleHalfHeight_WithoutHemisphere());
+
+	const int32 Index = Bottoms.Add(Center - AxisOffset);
+	Tops.Add(Center + AxisOffset);
+	Radii.Add(Radius);
+
+	// Une capsule plus petite qu'une cellule chevauche au plus quatre cellules
+	const int32 MinX = FMath::FloorToInt((Center.X - Radius) / CellSize);
+	const int32 MaxX = FMath::FloorToInt((Center.X + Radius) / CellSize);
+	const int32 MinY = FMath::FloorToInt((Center.Y - Radius) / CellSize);
+	const int32 MaxY = FMath::FloorToInt((Center.Y + Radius) / CellSize);
+
+	for (int32 X = MinX; X <= MaxX; ++X)
+	{
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			Cells.Add({ GetCellKey(X, Y), Index });
+		}
+	}
+
+	return Index;
+}
+
+void FSDTCapsuleHash::Finalize()
+{
+	Cells.Sort([](const FCell& A, const FCell& B) { return A.Key < B.Key; });
+}
+
+float FSDTCapsuleHash::DistSquaredToSegment(int32 Capsule, const FVector& A, const FVector& B, FVector& OutOnSegment) const
+{
+	FVector OnAxis;
+	FMath::SegmentDistToSegmentSafe(A, B, Bottoms[Capsule], Tops[Capsule], OutOnSegment, OnAxis);
+	return FVector::DistSquared(OutOnSegment, OnAxis);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+class UCapsuleComponent;
+
+/**
+ * Table de hachage spatiale 2D de capsules verticales, reconstruite à chaque frame.
+ * Les paires (cellule, capsule) sont stockées dans un tableau trié par clé: une requête est une
+ * recherche binaire par cellule couverte, sans allocation. Une capsule peut apparaître dans plusieurs
+ * cellules; un même candidat peut donc être visité plus d'une fois par requête.
+ * Partagée par les tests de contact (projectiles, rencontres joueur/IA).
+ */
+struct SOFTDESIGNTRAINING_API FSDTCapsuleHash
+{
+public:
+	void Reset(float InCellSize);
+
+	// Ajoute une capsule (axe + rayon) et retourne son index
+	int32 Add(const UCapsuleComponent& Capsule);
+
+	// À appeler après les ajouts, avant les requêtes
+	void Finalize();
+
+	int32 Num() const { return Bottoms.Num(); }
+
+	// Distance au carré entre le segment [A, B] et l'axe de la capsule (à comparer à (GetRadius + R)²)
+	float DistSquaredToSegment(int32 Capsule, const FVector& A, const FVector& B, FVector& OutOnSegment) const;
+	float GetRadius(int32 Capsule) const { return Radii[Capsule]; }
+	const FVector& GetBottom(int32 Capsule) const { return Bottoms[Capsule]; }
+	const FVector& GetTop(int32 Capsule) const { return Tops[Capsule]; }
+
+	// Visite chaque capsule dont une cellule intersecte la boîte XY [Min, Max]
+	template <typename VisitorType>
+	void ForEachCandidate(const FVector& Min, const FVector& Max, VisitorType&& Visitor) const
+	{
+		const int32 MinX = FMath::FloorToInt(Min.X / CellSize);
+		const int32 MaxX = FMath::FloorToInt(Max.X / CellSize);
+		const int32 MinY = FMath::FloorToInt(Min.Y / CellSize);
+		const int32 MaxY = FMath::FloorToInt(Max.Y / CellSize);
+
+		for (int32 X = MinX; X <= MaxX; ++X)
+		{
+			for (int32 Y = MinY; Y <= MaxY; ++Y)
+			{
+				const int64 Key = GetCellKey(X, Y);
+				for (int32 CellIndex = Algo::LowerBoundBy(Cells, Key, &FCell::Key); CellIndex < Cells.Num() && Cells[CellIndex].Key == Key; ++CellIndex)
+				{
+					Visitor(Cells[CellIndex].Capsule);
+				}
+			}
+		}
+	}
+
+private:
+	struct FCell
+	{
+		int64 Key;
+		int32 Capsule;
+	};
+
+	static int64 GetCellKey(int32 X, int32 Y) { return (static_cast<int64>(X) << 32) | static_cast<uint32>(Y); }
+
+	float CellSize = 500.f;
+	TArray<FVector> Bottoms;
+	TArray<FVector> Tops;
+	TArray<float> Radii;
+	TArray<FCell> Cells;
+};
@@ -8,21 +8,77 @@ ASDTCollectible::ASDTCollectible()
 
 }
 
+void ASDTCollectible::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (m_UseInstancedRendering)
+    {
+        if (USDTInstancedMeshSubsystem* instanced = GetWorld()->GetSubsystem<USDTInstancedMeshSubsystem>())
+        {
+            UStaticMeshComponent* meshComponent = GetStaticMeshComponent();
+            m_Instance = instanced->AddInstance(meshComponent->GetStaticMesh(), meshComponent->GetMaterial(0), meshComponent->GetComponentTransform());
+
+            if (m_Instance.IsValid())
+            {
+                meshComponent->SetVisibility(false);
+            }
+        }
+    }
+}
+
+void ASDTCollectible::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USDTCooldownSubsystem* cooldowns = GetWorld()->GetSubsystem<USDTCooldownSubsystem>())
+    {
+        cooldowns->Cancel(m_CollectCooldown);
+    }
+
+    // Rend l'instance au sous-système pour qu'elle soit réutilisée
+    if (USDTInstancedMeshSubsystem* instanced = GetWorld()->GetSubsystem<USDTInstancedMeshSubsystem>())
+    {
+        instanced->RemoveInstance(m_Instance);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASDTCollectible::SetCollectibleVisible(bool visible)
+{
+    if (m_Instance.IsValid())
+    {
+        if (USDTInstancedMeshSubsystem* instanced = GetWorld()->GetSubsystem<USDTInstancedMeshSubsystem>())
+        {
+            instanced->SetInstanceHidden(m_Instance, !visible);
+        }
+    }
+    else
+    {
+        GetStaticMeshComponent()->SetVisibility(visible);
+    }
+}
+
 void ASDTCollectible::Collect()
 {
-    GetWorld()->GetTimerManager().SetTimer(m_CollectCooldownTimer, this, &ASDTCollectible::OnCooldownDone, m_CollectCooldownDuration, false);
+    m_CooldownEndTime = GetWorld()->GetTimeSeconds() + m_CollectCooldownDuration;
+
+    if (USDTCooldownSubsystem* cooldowns = GetWorld()->GetSubsystem<USDTCooldownSubsystem>())
+    {
+        cooldowns->Cancel(m_CollectCooldown);
+        m_CollectCooldown = cooldowns->Start(m_CollectCooldownDuration, FSimpleDelegate::CreateUObject(this, &ASDTCollectible::OnCooldownDone));
+    }
 
-    GetStaticMeshComponent()->SetVisibility(false);
+    SetCollectibleVisible(false);
 }
 
 void ASDTCollectible::OnCooldownDone()
 {
-    GetWorld()->GetTimerManager().ClearTimer(m_CollectCooldownTimer);
+    m_CollectCooldown.Invalidate();
 
-    GetStaticMeshComponent()->SetVisibility(true);
+    SetCollectibleVisible(true);
 }
 
 bool ASDTCollectible::IsOnCooldown()
 {
-    return m_CollectCooldownTimer.IsValid();
+    return GetWorld()->GetTimeSeconds() < m_CooldownEndTime;
 }
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Engine/StaticMeshActor.h"
+#include "SDTInstancedMeshSubsystem.h"
+#include "SDTCooldownSubsystem.h"
 #include "SDTCollectible.generated.h"
 
 /**
@@ -16,6 +18,9 @@ class SOFTDESIGNTRAINING_API ASDTCollectible : public AStaticMeshActor
 public:
     ASDTCollectible();
 
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     void Collect();
     void OnCooldownDone();
     bool IsOnCooldown();
@@ -23,7 +28,16 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = AI)
     float m_CollectCooldownDuration = 10.f;
 
+    // Rendu par instance partagée; l'acteur garde seulement sa collision pour le ramassage
+    UPROPERTY(EditAnywhere, Category = Rendering)
+    bool m_UseInstancedRendering = false;
+
 protected:
-    FTimerHandle m_CollectCooldownTimer;
+    void SetCollectibleVisible(bool visible);
+
+    // Fin du cooldown en temps de jeu: IsOnCooldown est une simple comparaison
+    double m_CooldownEndTime = 0.0;
+    FSDTCooldownHandle m_CollectCooldown;
+    FSDTInstanceHandle m_Instance;
 	
 };
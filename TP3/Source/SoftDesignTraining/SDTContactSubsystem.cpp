@@ -0,0 +1,112 @@
+#include "SDTContactSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "SoftDesignTrainingCharacter.h"
+#include "SoftDesignTrainingMainCharacter.h"
+#include "Components/CapsuleComponent.h"
+
+void USDTContactSubsystem::Deinitialize()
+{
+	m_Player = nullptr;
+	m_Characters.Empty();
+	m_Touching.Empty();
+	m_TouchingThisFrame.Empty();
+	m_CapsuleOwners.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTContactSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTContactSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTContactSubsystem, STATGROUP_Tickables);
+}
+
+void USDTContactSubsystem::RegisterCharacter(ASoftDesignTrainingCharacter* Character)
+{
+	if (!bEnabled || !Character)
+		return;
+
+	if (ASoftDesignTrainingMainCharacter* Player = Cast<ASoftDesignTrainingMainCharacter>(Character))
+	{
+		m_Player = Player;
+
+		// Le contact joueur/IA passe par ce service: plus d'overlap entre la capsule du joueur et les pawns
+		Player->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+		return;
+	}
+
+	m_Characters.AddUnique(Character);
+}
+
+void USDTContactSubsystem::UnregisterCharacter(ASoftDesignTrainingCharacter* Character)
+{
+	if (Character == m_Player)
+	{
+		m_Player = nullptr;
+		m_Touching.Reset();
+		return;
+	}
+
+	m_Characters.RemoveSingleSwap(Character);
+	m_Touching.Remove(Character);
+}
+
+void USDTContactSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UCapsuleComponent* PlayerCapsule = IsValid(m_Player) ? m_Player->GetCapsuleComponent() : nullptr;
+	if (!PlayerCapsule || m_Characters.Num() == 0)
+		return;
+
+	m_CapsuleOwners.Reset();
+	m_CapsuleHash.Reset(HashCellSize);
+
+	for (ASoftDesignTrainingCharacter* Character : m_Characters)
+	{
+		if (const UCapsuleComponent* Capsule = IsValid(Character) ? Character->GetCapsuleComponent() : nullptr)
+		{
+			m_CapsuleHash.Add(*Capsule);
+			m_CapsuleOwners.Add(Character);
+		}
+	}
+	m_CapsuleHash.Finalize();
+
+	const FVector PlayerCenter = PlayerCapsule->GetComponentLocation();
+	const float PlayerRadius = PlayerCapsule->GetScaledCapsuleRadius();
+	const FVector AxisOffset(0.f, 0.f, PlayerCapsule->GetScaledCapsuleHalfHeight_WithoutHemisphere());
+	const FVector Extent(PlayerRadius, PlayerRadius, 0.f);
+
+	// Capsule contre capsule: distance entre les deux axes
+	m_TouchingThisFrame.Reset();
+	m_CapsuleHash.ForEachCandidate(PlayerCenter - Extent, PlayerCenter + Extent, [&](int32 Capsule)
+	{
+		FVector OnPlayerAxis;
+		const float ContactRadius = PlayerRadius + m_CapsuleHash.GetRadius(Capsule);
+		if (m_CapsuleHash.DistSquaredToSegment(Capsule, PlayerCenter - AxisOffset, PlayerCenter + AxisOffset, OnPlayerAxis) <= FMath::Square(ContactRadius))
+		{
+			m_TouchingThisFrame.Add(m_CapsuleOwners[Capsule]);
+		}
+	});
+
+	// Réponses hors du parcours: Die() et la réinitialisation du joueur téléportent les personnages
+	TArray<ASoftDesignTrainingCharacter*, TInlineAllocator<8>> NewContacts;
+	for (const TWeakObjectPtr<ASoftDesignTrainingCharacter>& Character : m_TouchingThisFrame)
+	{
+		if (!m_Touching.Contains(Character) && Character.IsValid())
+		{
+			NewContacts.Add(Character.Get());
+		}
+	}
+
+	Swap(m_Touching, m_TouchingThisFrame);
+
+	for (ASoftDesignTrainingCharacter* Character : NewContacts)
+	{
+		Character->OnPlayerContact(m_Player);
+		m_Player->OnAIContact(Character);
+	}
+}
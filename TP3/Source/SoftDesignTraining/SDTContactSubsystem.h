@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTCapsuleHash.h"
+#include "SDTContactSubsystem.generated.h"
+
+class ASoftDesignTrainingCharacter;
+class ASoftDesignTrainingMainCharacter;
+
+/**
+ * Détection des rencontres joueur/IA sans overlaps physiques entre pawns.
+ * Chaque frame, les capsules des IA sont rangées dans une table de hachage spatiale et seule la
+ * capsule du joueur y est testée. Les contacts sont détectés sur front montant (entrée en contact)
+ * et déclenchent les mêmes réponses que les anciens OnBeginOverlap.
+ * Quand le service est actif, la capsule du joueur ignore le canal Pawn (les IA l'ignorent déjà):
+ * plus aucune paire de pawns ne génère d'overlap.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTContactSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(ASoftDesignTrainingCharacter* Character);
+	void UnregisterCharacter(ASoftDesignTrainingCharacter* Character);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UPROPERTY(Config)
+	bool bEnabled = true;
+
+	UPROPERTY(Config)
+	float HashCellSize = 500.f;
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<ASoftDesignTrainingMainCharacter> m_Player;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ASoftDesignTrainingCharacter>> m_Characters;
+
+	// IA en contact avec le joueur à la frame précédente (front montant)
+	TSet<TWeakObjectPtr<ASoftDesignTrainingCharacter>> m_Touching;
+	TSet<TWeakObjectPtr<ASoftDesignTrainingCharacter>> m_TouchingThisFrame;
+
+	TArray<ASoftDesignTrainingCharacter*> m_CapsuleOwners;
+	FSDTCapsuleHash m_CapsuleHash;
+};
@@ -0,0 +1,155 @@
+#include "SDTCooldownSubsystem.h"
+#include "SoftDesignTraining.h"
+
+void USDTCooldownSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SlotDuration = FMath::Max(SlotDuration, 0.01f);
+	NumSlots = FMath::Max(NumSlots, 1);
+	m_Slots.SetNum(NumSlots);
+}
+
+void USDTCooldownSubsystem::Deinitialize()
+{
+	m_Slots.Empty();
+	m_Expiries.Empty();
+	m_Generations.Empty();
+	m_Callbacks.Empty();
+	m_FreeIndices.Empty();
+	m_ExpiredThisFrame.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTCooldownSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTCooldownSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTCooldownSubsystem, STATGROUP_Tickables);
+}
+
+double USDTCooldownSubsystem::GetTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+FSDTCooldownHandle USDTCooldownSubsystem::Start(float Duration, FSimpleDelegate OnExpired)
+{
+	const double Expiry = GetTime() + FMath::Max(Duration, 0.f);
+
+	int32 Index;
+	if (m_FreeIndices.Num() > 0)
+	{
+		Index = m_FreeIndices.Pop();
+	}
+	else
+	{
+		Index = m_Expiries.AddUninitialized();
+		m_Generations.Add(0);
+		m_Callbacks.AddDefaulted();
+	}
+
+	m_Expiries[Index] = Expiry;
+	m_Callbacks[Index] = MoveTemp(OnExpired);
+
+	// Une case déjà traitée ne sera revisitée qu'au prochain tour: on vise au moins la case suivante
+	const int64 Tick = FMath::Max(GetTickForTime(Expiry), m_LastProcessedTick + 1);
+	GetSlot(Tick).Add({ Index, m_Generations[Index] });
+
+	FSDTCooldownHandle Handle;
+	Handle.Index = Index;
+	Handle.Generation = m_Generations[Index];
+	return Handle;
+}
+
+bool USDTCooldownSubsystem::IsEntryLive(int32 Index, uint32 Generation) const
+{
+	return m_Generations.IsValidIndex(Index) && m_Generations[Index] == Generation && m_Expiries[Index] != DBL_MAX;
+}
+
+void USDTCooldownSubsystem::FreeEntry(int32 Index)
+{
+	// Changer de génération invalide tous les handles et les entrées de la roue qui pointent ici
+	++m_Generations[Index];
+	m_Expiries[Index] = DBL_MAX;
+	m_Callbacks[Index].Unbind();
+	m_FreeIndices.Add(Index);
+}
+
+void USDTCooldownSubsystem::Cancel(FSDTCooldownHandle& Handle)
+{
+	if (Handle.IsValid() && IsEntryLive(Handle.Index, Handle.Generation))
+	{
+		FreeEntry(Handle.Index);
+	}
+	Handle.Invalidate();
+}
+
+bool USDTCooldownSubsystem::IsActive(const FSDTCooldownHandle& Handle) const
+{
+	return Handle.IsValid() && IsEntryLive(Handle.Index, Handle.Generation);
+}
+
+float USDTCooldownSubsystem::GetRemaining(const FSDTCooldownHandle& Handle) const
+{
+	if (!IsActive(Handle))
+		return 0.f;
+
+	return FMath::Max(0.f, static_cast<float>(m_Expiries[Handle.Index] - GetTime()));
+}
+
+void USDTCooldownSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetTime();
+	// Dernière case entièrement écoulée: toutes ses échéances de ce tour sont passées (latence <= SlotDuration)
+	const int64 CurrentTick = GetTickForTime(Now) - 1;
+
+	// Premières frames (Now < SlotDuration): aucune case n'est encore écoulée
+	if (CurrentTick <= m_LastProcessedTick)
+		return;
+
+	// Après une longue frame, un tour complet suffit: chaque case n'existe qu'une fois
+	const int64 FirstTick = FMath::Max3<int64>(m_LastProcessedTick + 1, CurrentTick - NumSlots + 1, 0);
+
+	for (int64 Tick = FirstTick; Tick <= CurrentTick; ++Tick)
+	{
+		TArray<FSlotEntry>& Slot = GetSlot(Tick);
+
+		for (int32 i = Slot.Num() - 1; i >= 0; --i)
+		{
+			const FSlotEntry Entry = Slot[i];
+
+			if (!IsEntryLive(Entry.Index, Entry.Generation))
+			{
+				Slot.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			}
+			else if (m_Expiries[Entry.Index] <= Now)
+			{
+				m_ExpiredThisFrame.Add(MoveTemp(m_Callbacks[Entry.Index]));
+				FreeEntry(Entry.Index);
+				Slot.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			}
+			// Sinon: échéance dans un tour suivant de la roue, l'entrée reste dans sa case
+		}
+	}
+
+	m_LastProcessedTick = CurrentTick;
+
+	// Déclenchement en lot: les callbacks peuvent relancer des délais sans perturber le parcours
+	if (m_ExpiredThisFrame.Num() > 0)
+	{
+		TArray<FSimpleDelegate> Expired = MoveTemp(m_ExpiredThisFrame);
+		m_ExpiredThisFrame.Reset();
+
+		for (FSimpleDelegate& Callback : Expired)
+		{
+			Callback.ExecuteIfBound();
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTCooldownSubsystem.generated.h"
+
+// Référence vers un compte à rebours; invalide une fois expiré ou annulé
+struct FSDTCooldownHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; }
+};
+
+/**
+ * Service central de délais (collectibles, power-up, perte de LOS) basé sur une roue temporelle.
+ * Les échéances sont stockées dans un tableau compact; chaque case de la roue couvre SlotDuration
+ * secondes et n'est visitée qu'une fois par tour, lorsque le temps de jeu l'a dépassée. Les expirations
+ * d'une frame sont déclenchées en lot, après le parcours de la roue (au plus SlotDuration de retard).
+ *
+ * Remplace les FTimerHandle individuels: le tas du FTimerManager ne grossit plus avec le nombre
+ * de collectibles, et "est-ce encore actif?" devient une comparaison de temps.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTCooldownSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Démarre un délai; OnExpired est appelé (en lot, pendant le tick du service) à l'échéance
+	FSDTCooldownHandle Start(float Duration, FSimpleDelegate OnExpired = FSimpleDelegate());
+
+	// Annule le délai (sans appeler OnExpired) et invalide le handle
+	void Cancel(FSDTCooldownHandle& Handle);
+
+	// Vrai tant que OnExpired n'a pas été déclenché ni le délai annulé
+	bool IsActive(const FSDTCooldownHandle& Handle) const;
+	float GetRemaining(const FSDTCooldownHandle& Handle) const;
+
+	double GetTime() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Résolution de la roue
+	UPROPERTY(Config)
+	float SlotDuration = 0.1f;
+
+	// Nombre de cases: au-delà de NumSlots * SlotDuration, un délai fait plusieurs tours
+	UPROPERTY(Config)
+	int32 NumSlots = 256;
+
+private:
+	struct FSlotEntry
+	{
+		int32 Index;
+		uint32 Generation;
+	};
+
+	int64 GetTickForTime(double Time) const { return FMath::FloorToInt64(Time / SlotDuration); }
+	// Case de la roue pour un tick (modulo non négatif)
+	TArray<FSlotEntry>& GetSlot(int64 Tick) { return m_Slots[((Tick % NumSlots) + NumSlots) % NumSlots]; }
+	bool IsEntryLive(int32 Index, uint32 Generation) const;
+	void FreeEntry(int32 Index);
+
+	TArray<TArray<FSlotEntry>> m_Slots;
+	// Le temps du monde part de 0: -1 veut dire qu'aucune case n'a encore été traitée
+	int64 m_LastProcessedTick = -1;
+
+	// Tableau compact des délais (index = FSDTCooldownHandle::Index)
+	TArray<double> m_Expiries;
+	TArray<uint32> m_Generations;
+	TArray<FSimpleDelegate> m_Callbacks;
+	TArray<int32> m_FreeIndices;
+
+	TArray<FSimpleDelegate> m_ExpiredThisFrame;
+};
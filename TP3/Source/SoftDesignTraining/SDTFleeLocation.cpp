@@ -2,6 +2,7 @@
 
 #include "SDTFleeLocation.h"
 #include "SoftDesignTraining.h"
+#include "SDTThreatMapSubsystem.h"
 
 
 // Sets default values
@@ -16,7 +17,21 @@ ASDTFleeLocation::ASDTFleeLocation()
 void ASDTFleeLocation::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	if (USDTThreatMapSubsystem* ThreatMap = GetWorld()->GetSubsystem<USDTThreatMapSubsystem>())
+	{
+		ThreatMap->RegisterFleeLocation(this);
+	}
+}
+
+void ASDTFleeLocation::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USDTThreatMapSubsystem* ThreatMap = GetWorld()->GetSubsystem<USDTThreatMapSubsystem>())
+	{
+		ThreatMap->UnregisterFleeLocation(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
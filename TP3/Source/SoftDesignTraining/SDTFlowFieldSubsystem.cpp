@@ -0,0 +1,187 @@
+#include "SDTFlowFieldSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "NavigationSystem.h"
+
+void USDTFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &USDTFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+
+	// Navmesh statique déjà chargé avec la carte
+	RebuildGrid();
+}
+
+void USDTFlowFieldSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &USDTFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+
+	m_Grid.Reset();
+	Super::Deinitialize();
+}
+
+bool USDTFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+void USDTFlowFieldSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	RebuildGrid();
+}
+
+void USDTFlowFieldSubsystem::RebuildGrid()
+{
+	m_Grid.Build(GetWorld(), CellSize);
+	m_FieldGoalIndex = INDEX_NONE;
+	m_IntegrationCosts.Reset();
+	m_FieldCells.Reset();
+	m_NextCell.Init(INDEX_NONE, m_Grid.Num());
+
+	// La cible reste valide, on la reprojette sur la nouvelle grille
+	if (m_GoalIndex != INDEX_NONE)
+	{
+		m_GoalIndex = m_Grid.GetIndex(m_GoalLocation);
+	}
+}
+
+void USDTFlowFieldSubsystem::SetGoalLocation(const FVector& Location)
+{
+	m_GoalLocation = Location;
+
+	const int32 NewIndex = m_Grid.GetIndex(Location);
+	if (NewIndex != INDEX_NONE && m_Grid.IsWalkable(NewIndex))
+	{
+		m_GoalIndex = NewIndex;
+	}
+}
+
+void USDTFlowFieldSubsystem::AddConsumer()
+{
+	// Premier consommateur: le champ doit être prêt dès sa première lecture
+	if (m_NumConsumers++ == 0 && m_GoalIndex != INDEX_NONE && m_GoalIndex != m_FieldGoalIndex)
+	{
+		RecomputeField();
+	}
+}
+
+void USDTFlowFieldSubsystem::RemoveConsumer()
+{
+	m_NumConsumers = FMath::Max(m_NumConsumers - 1, 0);
+}
+
+void USDTFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Une seule mise à jour par frame, seulement si quelqu'un lit le champ et que la cible a changé de cellule
+	if (m_NumConsumers > 0 && m_GoalIndex != INDEX_NONE && m_GoalIndex != m_FieldGoalIndex)
+	{
+		RecomputeField();
+	}
+}
+
+void USDTFlowFieldSubsystem::RecomputeField()
+{
+	m_FieldGoalIndex = m_GoalIndex;
+	++m_FieldVersion;
+
+	// Seules les cellules de l'ancien champ sont remises à zéro, puis propagation bornée autour de la cible
+	for (const int32 Index : m_FieldCells)
+	{
+		m_NextCell[Index] = INDEX_NONE;
+	}
+	m_Grid.UpdateIntegrationField(m_GoalIndex, m_IntegrationCosts, m_FieldCells, MaxFieldDistance);
+
+	int32 Neighbours[8];
+	float StepCosts[8];
+
+	for (const int32 Index : m_FieldCells)
+	{
+		if (Index == m_GoalIndex)
+			continue;
+
+		float BestCost = m_IntegrationCosts[Index];
+		const int32 Count = m_Grid.GetNeighbours(Index, Neighbours, StepCosts);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			if (m_IntegrationCosts[Neighbours[i]] < BestCost)
+			{
+				BestCost = m_IntegrationCosts[Neighbours[i]];
+				m_NextCell[Index] = Neighbours[i];
+			}
+		}
+	}
+}
+
+bool USDTFlowFieldSubsystem::GetFlowDirection(const FVector& Location, FVector& OutDirection) const
+{
+	if (m_FieldGoalIndex == INDEX_NONE)
+		return false;
+
+	const int32 Index = m_Grid.GetIndex(Location);
+	if (Index == INDEX_NONE)
+		return false;
+
+	FVector Target;
+	if (Index == m_FieldGoalIndex)
+	{
+		Target = m_GoalLocation;
+	}
+	else if (m_NextCell.IsValidIndex(Index) && m_NextCell[Index] != INDEX_NONE)
+	{
+		Target = m_Grid.GetCellLocation(m_NextCell[Index]);
+	}
+	else
+	{
+		return false;
+	}
+
+	OutDirection = (Target - Location).GetSafeNormal2D();
+	return !OutDirection.IsNearlyZero();
+}
+
+float USDTFlowFieldSubsystem::GetDistanceToGoal(const FVector& Location) const
+{
+	const int32 Index = m_Grid.GetIndex(Location);
+	if (m_FieldGoalIndex == INDEX_NONE || !m_IntegrationCosts.IsValidIndex(Index))
+		return FLT_MAX;
+
+	return m_IntegrationCosts[Index];
+}
+
+bool USDTFlowFieldSubsystem::GetFlowPath(const FVector& Start, TArray<FVector>& OutPoints) const
+{
+	OutPoints.Reset();
+
+	int32 Index = m_Grid.GetIndex(Start);
+	if (m_FieldGoalIndex == INDEX_NONE || !m_IntegrationCosts.IsValidIndex(Index) || m_IntegrationCosts[Index] == FLT_MAX)
+		return false;
+
+	// Le coût décroît strictement d'une cellule à la suivante: la descente se termine sur la cible
+	OutPoints.Add(Start);
+	while (Index != m_FieldGoalIndex)
+	{
+		Index = m_NextCell[Index];
+		if (Index == INDEX_NONE)
+		{
+			OutPoints.Reset();
+			return false;
+		}
+		OutPoints.Add(m_Grid.GetCellLocation(Index));
+	}
+	OutPoints.Add(m_GoalLocation);
+
+	return true;
+}
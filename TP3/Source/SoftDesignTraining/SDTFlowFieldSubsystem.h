@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTNavGrid.h"
+#include "SDTFlowFieldSubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ * Champ de flux centré sur le joueur (ou sur la LKP partagée du groupe de poursuite).
+ * Un seul champ d'intégration (Dijkstra sur FSDTNavGrid) est maintenu pour tout le monde et n'est
+ * recalculé que lorsque la cible change de cellule. Chaque poursuivant lit ensuite sa direction
+ * dans le champ: le coût par agent devient une simple lecture tableau au lieu d'une requête de chemin.
+ *
+ * Le recalcul ne remet à zéro que les cellules atteintes par l'ancien champ et ne propage que jusqu'à
+ * MaxFieldDistance autour de la nouvelle cible: son coût suit la zone des deux rayons, pas la taille de
+ * la grille. Une vraie réparation (type D* Lite) n'apporterait rien ici: la cible change de cellule et
+ * la quasi-totalité des coûts du rayon change avec elle.
+ *
+ * Consommateurs: le Move To de la branche Chase du BT (chemin construit depuis le champ par
+ * USDTPathFollowingComponent) et UBTTask_SDT_FollowFlowField. Sans consommateur rien n'est calculé.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Nouvelle cible du champ (joueur vu ou LKP). Ne fait que marquer le champ sale si la cellule change.
+	void SetGoalLocation(const FVector& Location);
+
+	bool HasGoal() const { return m_GoalIndex != INDEX_NONE; }
+
+	// Un consommateur s'enregistre tant qu'il lit le champ; sans consommateur rien n'est calculé
+	void AddConsumer();
+	void RemoveConsumer();
+	const FVector& GetGoalLocation() const { return m_GoalLocation; }
+
+	// Direction XY normalisée à suivre depuis Location. False si la position est hors du champ.
+	bool GetFlowDirection(const FVector& Location, FVector& OutDirection) const;
+
+	// Distance de chemin restante jusqu'à la cible (FLT_MAX si inconnue)
+	float GetDistanceToGoal(const FVector& Location) const;
+
+	// Chemin Start -> cible en suivant le champ cellule par cellule. False si Start est hors du champ.
+	bool GetFlowPath(const FVector& Start, TArray<FVector>& OutPoints) const;
+
+	// Incrémenté à chaque recalcul: un chemin construit depuis le champ est périmé si la version change
+	int32 GetFieldVersion() const { return m_FieldVersion; }
+	float GetCellSize() const { return m_Grid.GetCellSize(); }
+
+	void RebuildGrid();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	UPROPERTY(Config)
+	float CellSize = 100.f;
+
+	// Rayon (distance de chemin) au-delà duquel le champ n'est pas propagé
+	UPROPERTY(Config)
+	float MaxFieldDistance = 8000.f;
+
+private:
+	void RecomputeField();
+
+	FSDTNavGrid m_Grid;
+	TArray<float> m_IntegrationCosts;
+	// Cellules atteintes par le champ courant: les seules à remettre à zéro au prochain recalcul
+	TArray<int32> m_FieldCells;
+	// Pour chaque cellule: cellule voisine la moins coûteuse (INDEX_NONE si aucune)
+	TArray<int32> m_NextCell;
+	int32 m_FieldVersion = 0;
+
+	FVector m_GoalLocation = FVector::ZeroVector;
+	int32 m_GoalIndex = INDEX_NONE;
+	int32 m_FieldGoalIndex = INDEX_NONE;
+	int32 m_NumConsumers = 0;
+};
@@ -0,0 +1,523 @@
+#include "SDTHierarchicalPathSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	struct FSDTOpenPortal
+	{
+		int32 Node;
+		float G;
+		float F;
+	};
+
+	struct FSDTOpenPortalPredicate
+	{
+		bool operator()(const FSDTOpenPortal& A, const FSDTOpenPortal& B) const { return A.F < B.F; }
+	};
+}
+
+void USDTHierarchicalPathSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &USDTHierarchicalPathSubsystem::OnNavigationGenerationFinished);
+		m_NavigationDirtiedHandle = NavSys->OnNavigationDirtied.AddUObject(this, &USDTHierarchicalPathSubsystem::OnNavigationDirtied);
+	}
+
+	Rebuild();
+}
+
+void USDTHierarchicalPathSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &USDTHierarchicalPathSubsystem::OnNavigationGenerationFinished);
+		NavSys->OnNavigationDirtied.Remove(m_NavigationDirtiedHandle);
+	}
+
+	m_Portals.Empty();
+	m_FreePortals.Empty();
+	m_BorderPortals.Empty();
+	m_Clusters.Empty();
+	m_PendingClusters.Empty();
+	m_DirtyBounds.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTHierarchicalPathSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTHierarchicalPathSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTHierarchicalPathSubsystem, STATGROUP_Tickables);
+}
+
+const ANavigationData* USDTHierarchicalPathSubsystem::GetNavData() const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	return NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+}
+
+void USDTHierarchicalPathSubsystem::OnNavigationDirtied(const FBox& DirtyBounds)
+{
+	// Les tuiles ne sont pas encore reconstruites: on attend la fin de la génération
+	m_DirtyBounds.Add(DirtyBounds);
+}
+
+void USDTHierarchicalPathSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	const ANavigationData* DefaultNavData = GetNavData();
+	if (NavData != DefaultNavData)
+		return;
+
+	// Première génération, zone inconnue ou bornes changées: la grille de clusters elle-même est à refaire
+	if (m_Clusters.Num() == 0 || m_DirtyBounds.Num() == 0 || !(DefaultNavData->GetBounds() == m_NavBounds))
+	{
+		Rebuild();
+		return;
+	}
+
+	TSet<int32> DirtyClusters;
+	for (const FBox& Bounds : m_DirtyBounds)
+	{
+		const FBox Expanded = Bounds.ExpandBy(PortalSampleSpacing);
+		const int32 MinX = FMath::Clamp(FMath::FloorToInt((Expanded.Min.X - m_Origin.X) / ClusterSize), 0, m_ClusterCount.X - 1);
+		const int32 MinY = FMath::Clamp(FMath::FloorToInt((Expanded.Min.Y - m_Origin.Y) / ClusterSize), 0, m_ClusterCount.Y - 1);
+		const int32 MaxX = FMath::Clamp(FMath::FloorToInt((Expanded.Max.X - m_Origin.X) / ClusterSize), 0, m_ClusterCount.X - 1);
+		const int32 MaxY = FMath::Clamp(FMath::FloorToInt((Expanded.Max.Y - m_Origin.Y) / ClusterSize), 0, m_ClusterCount.Y - 1);
+
+		for (int32 Cy = MinY; Cy <= MaxY; ++Cy)
+		{
+			for (int32 Cx = MinX; Cx <= MaxX; ++Cx)
+			{
+				DirtyClusters.Add(Cy * m_ClusterCount.X + Cx);
+			}
+		}
+	}
+	m_DirtyBounds.Reset();
+
+	// Les quatre frontières d'un cluster sale sont rééchantillonnées, ce qui salit aussi le voisin d'en face
+	TSet<int32> DirtyBorders;
+	TSet<int32> ClustersToRefresh = DirtyClusters;
+	for (const int32 Cluster : DirtyClusters)
+	{
+		const int32 Cx = Cluster % m_ClusterCount.X;
+		const int32 Cy = Cluster / m_ClusterCount.X;
+
+		DirtyBorders.Add(Cluster * 2);
+		DirtyBorders.Add(Cluster * 2 + 1);
+		if (Cx + 1 < m_ClusterCount.X)
+			ClustersToRefresh.Add(Cluster + 1);
+		if (Cy + 1 < m_ClusterCount.Y)
+			ClustersToRefresh.Add(Cluster + m_ClusterCount.X);
+		if (Cx > 0)
+		{
+			DirtyBorders.Add((Cluster - 1) * 2);
+			ClustersToRefresh.Add(Cluster - 1);
+		}
+		if (Cy > 0)
+		{
+			DirtyBorders.Add((Cluster - m_ClusterCount.X) * 2 + 1);
+			ClustersToRefresh.Add(Cluster - m_ClusterCount.X);
+		}
+	}
+
+	for (const int32 Border : DirtyBorders)
+	{
+		SampleBorder(Border);
+	}
+
+	for (const int32 Cluster : ClustersToRefresh)
+	{
+		RefreshClusterPortals(Cluster);
+	}
+
+	m_BuildStartTime = FPlatformTime::Seconds();
+}
+
+void USDTHierarchicalPathSubsystem::Rebuild()
+{
+	m_Portals.Reset();
+	m_FreePortals.Reset();
+	m_BorderPortals.Reset();
+	m_Clusters.Reset();
+	m_PendingClusters.Reset();
+	m_DirtyBounds.Reset();
+	m_BuildI = 0;
+	m_BuildJ = 1;
+	m_ClusterCount = FIntPoint::ZeroValue;
+
+	const ANavigationData* NavData = GetNavData();
+	if (!NavData)
+		return;
+
+	m_NavBounds = NavData->GetBounds();
+	if (!m_NavBounds.IsValid)
+		return;
+
+	// Carte plus petite qu'un cluster: la couche hiérarchique n'apporte rien
+	const FVector Size = m_NavBounds.GetSize();
+	if (Size.X <= ClusterSize && Size.Y <= ClusterSize)
+		return;
+
+	m_BuildStartTime = FPlatformTime::Seconds();
+
+	m_Origin = m_NavBounds.Min;
+	m_CenterZ = m_NavBounds.GetCenter().Z;
+	m_ProjectionHalfHeight = Size.Z * 0.5f + 50.f;
+	m_ClusterCount.X = FMath::Max(1, FMath::CeilToInt(Size.X / ClusterSize));
+	m_ClusterCount.Y = FMath::Max(1, FMath::CeilToInt(Size.Y / ClusterSize));
+
+	const int32 NumClusters = m_ClusterCount.X * m_ClusterCount.Y;
+	m_Clusters.SetNum(NumClusters);
+	m_BorderPortals.SetNum(NumClusters * 2);
+
+	// Les portails ne coûtent qu'une projection par échantillon; les coûts internes sont étalés dans Tick
+	for (int32 Border = 0; Border < m_BorderPortals.Num(); ++Border)
+	{
+		SampleBorder(Border);
+	}
+
+	for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+	{
+		RefreshClusterPortals(Cluster);
+	}
+
+	UE_LOG(LogSoftDesignTraining, Log, TEXT("SDTHierarchicalPath: %dx%d clusters, %d portails (%.1f ms)"),
+		m_ClusterCount.X, m_ClusterCount.Y, m_Portals.Num() - m_FreePortals.Num(), (FPlatformTime::Seconds() - m_BuildStartTime) * 1000.0);
+}
+
+void USDTHierarchicalPathSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (m_PendingClusters.Num() == 0)
+		return;
+
+	const ANavigationData* NavData = GetNavData();
+	if (!NavData)
+		return;
+
+	int32 Budget = MaxEdgeQueriesPerTick;
+	while (Budget > 0 && m_PendingClusters.Num() > 0)
+	{
+		FCluster& Cluster = m_Clusters[m_PendingClusters[0]];
+		const int32 NumPortals = Cluster.Portals.Num();
+
+		if (m_BuildJ >= NumPortals)
+		{
+			++m_BuildI;
+			m_BuildJ = m_BuildI + 1;
+		}
+
+		if (m_BuildI >= NumPortals - 1)
+		{
+			Cluster.bEdgesReady = true;
+			m_PendingClusters.RemoveAt(0);
+			m_BuildI = 0;
+			m_BuildJ = 1;
+
+			if (m_PendingClusters.Num() == 0)
+			{
+				UE_LOG(LogSoftDesignTraining, Log, TEXT("SDTHierarchicalPath: coûts internes à jour (%.1f s)"), FPlatformTime::Seconds() - m_BuildStartTime);
+			}
+			continue;
+		}
+
+		const int32 A = Cluster.Portals[m_BuildI];
+		const int32 B = Cluster.Portals[m_BuildJ];
+
+		float Cost = 0.f;
+		if (GetLocalCost(*NavData, m_Portals[A].Location, m_Portals[B].Location, Cost))
+		{
+			Cluster.Edges[m_BuildI].Add({ B, Cost });
+			Cluster.Edges[m_BuildJ].Add({ A, Cost });
+		}
+
+		++m_BuildJ;
+		--Budget;
+	}
+}
+
+void USDTHierarchicalPathSubsystem::SampleBorder(int32 Border)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	// Les anciens portails sont libérés; les clusters voisins sont rafraîchis par l'appelant
+	TArray<int32>& BorderPortals = m_BorderPortals[Border];
+	m_FreePortals.Append(BorderPortals);
+	BorderPortals.Reset();
+
+	const int32 ClusterA = Border / 2;
+	const int32 Cx = ClusterA % m_ClusterCount.X;
+	const int32 Cy = ClusterA / m_ClusterCount.X;
+	const bool bPlusX = (Border % 2) == 0;
+
+	int32 ClusterB = INDEX_NONE;
+	FVector BorderStart;
+	FVector BorderDirection;
+	if (bPlusX && Cx + 1 < m_ClusterCount.X)
+	{
+		ClusterB = ClusterA + 1;
+		BorderStart = FVector(m_Origin.X + (Cx + 1) * ClusterSize, m_Origin.Y + Cy * ClusterSize, m_CenterZ);
+		BorderDirection = FVector(0.f, 1.f, 0.f);
+	}
+	else if (!bPlusX && Cy + 1 < m_ClusterCount.Y)
+	{
+		ClusterB = ClusterA + m_ClusterCount.X;
+		BorderStart = FVector(m_Origin.X + Cx * ClusterSize, m_Origin.Y + (Cy + 1) * ClusterSize, m_CenterZ);
+		BorderDirection = FVector(1.f, 0.f, 0.f);
+	}
+
+	if (!NavSys || ClusterB == INDEX_NONE)
+		return;
+
+	const FVector Extent(PortalSampleSpacing * 0.5f, PortalSampleSpacing * 0.5f, m_ProjectionHalfHeight);
+	const int32 NumSamples = FMath::Max(1, FMath::FloorToInt(ClusterSize / PortalSampleSpacing));
+
+	// Une suite d'échantillons navigables consécutifs = un passage = un portail en son milieu
+	TArray<FVector> Run;
+	auto FlushRun = [&]()
+	{
+		if (Run.Num() > 0)
+		{
+			const FPortal NewPortal{ Run[Run.Num() / 2], ClusterA, ClusterB, INDEX_NONE, INDEX_NONE };
+			const int32 Portal = m_FreePortals.Num() > 0 ? m_FreePortals.Pop() : m_Portals.AddUninitialized();
+			m_Portals[Portal] = NewPortal;
+			BorderPortals.Add(Portal);
+			Run.Reset();
+		}
+	};
+
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		const FVector Point = BorderStart + BorderDirection * ((Sample + 0.5f) * PortalSampleSpacing);
+
+		FNavLocation Projected;
+		if (NavSys->ProjectPointToNavigation(Point, Projected, Extent))
+		{
+			Run.Add(Projected.Location);
+		}
+		else
+		{
+			FlushRun();
+		}
+	}
+
+	FlushRun();
+}
+
+void USDTHierarchicalPathSubsystem::RefreshClusterPortals(int32 Cluster)
+{
+	const int32 Cx = Cluster % m_ClusterCount.X;
+	const int32 Cy = Cluster / m_ClusterCount.X;
+
+	// Frontières +X et +Y du cluster, et celles de ses voisins -X et -Y qui le bordent
+	FCluster& Data = m_Clusters[Cluster];
+	Data.Portals.Reset();
+	Data.Portals.Append(m_BorderPortals[Cluster * 2]);
+	Data.Portals.Append(m_BorderPortals[Cluster * 2 + 1]);
+	if (Cx > 0)
+		Data.Portals.Append(m_BorderPortals[(Cluster - 1) * 2]);
+	if (Cy > 0)
+		Data.Portals.Append(m_BorderPortals[(Cluster - m_ClusterCount.X) * 2 + 1]);
+
+	for (int32 Local = 0; Local < Data.Portals.Num(); ++Local)
+	{
+		FPortal& Portal = m_Portals[Data.Portals[Local]];
+		if (Portal.ClusterA == Cluster)
+		{
+			Portal.LocalA = Local;
+		}
+		else
+		{
+			Portal.LocalB = Local;
+		}
+	}
+
+	QueueCluster(Cluster);
+}
+
+void USDTHierarchicalPathSubsystem::QueueCluster(int32 Cluster)
+{
+	FCluster& Data = m_Clusters[Cluster];
+	Data.bEdgesReady = false;
+	Data.Edges.Reset();
+	Data.Edges.SetNum(Data.Portals.Num());
+
+	const int32 Position = m_PendingClusters.Find(Cluster);
+	if (Position == INDEX_NONE)
+	{
+		m_PendingClusters.Add(Cluster);
+	}
+	else if (Position == 0)
+	{
+		// Cluster en cours de calcul: on recommence ses paires
+		m_BuildI = 0;
+		m_BuildJ = 1;
+	}
+}
+
+bool USDTHierarchicalPathSubsystem::GetLocalCost(const ANavigationData& NavData, const FVector& From, const FVector& To, float& OutCost) const
+{
+	FVector HitLocation;
+	if (!NavData.Raycast(From, To, HitLocation, NavData.GetDefaultQueryFilter()))
+	{
+		OutCost = FVector::Dist(From, To);
+		return true;
+	}
+
+	FVector::FReal PathLength = 0.f;
+	if (NavData.CalcPathLength(From, To, PathLength) != ENavigationQueryResult::Success)
+		return false;
+
+	// Un détour plus long que deux clusters sort du cluster: ce n'est plus un lien local
+	if (PathLength > ClusterSize * 2.f)
+		return false;
+
+	OutCost = static_cast<float>(PathLength);
+	return true;
+}
+
+int32 USDTHierarchicalPathSubsystem::GetClusterIndex(const FVector& Location) const
+{
+	const int32 Cx = FMath::FloorToInt((Location.X - m_Origin.X) / ClusterSize);
+	const int32 Cy = FMath::FloorToInt((Location.Y - m_Origin.Y) / ClusterSize);
+
+	if (Cx < 0 || Cy < 0 || Cx >= m_ClusterCount.X || Cy >= m_ClusterCount.Y)
+		return INDEX_NONE;
+
+	return Cy * m_ClusterCount.X + Cx;
+}
+
+bool USDTHierarchicalPathSubsystem::FindAbstractPath(const FVector& Start, const FVector& End, TArray<FVector>& OutWaypoints) const
+{
+	OutWaypoints.Reset();
+
+	if (m_Clusters.Num() == 0 || FVector::Dist2D(Start, End) < MinHierarchicalDistance)
+		return false;
+
+	const int32 StartCluster = GetClusterIndex(Start);
+	const int32 GoalCluster = GetClusterIndex(End);
+	if (StartCluster == INDEX_NONE || GoalCluster == INDEX_NONE || StartCluster == GoalCluster)
+		return false;
+
+	const ANavigationData* NavData = GetNavData();
+	if (!NavData)
+		return false;
+
+	// Liens départ -> portails et portails -> arrivée vérifiés: un portail derrière un mur n'est pas un premier tronçon
+	TArray<FPortalEdge> StartEdges;
+	for (const int32 Portal : m_Clusters[StartCluster].Portals)
+	{
+		float Cost = 0.f;
+		if (GetLocalCost(*NavData, Start, m_Portals[Portal].Location, Cost))
+		{
+			StartEdges.Add({ Portal, Cost });
+		}
+	}
+
+	TMap<int32, float> GoalCosts;
+	for (const int32 Portal : m_Clusters[GoalCluster].Portals)
+	{
+		float Cost = 0.f;
+		if (GetLocalCost(*NavData, m_Portals[Portal].Location, End, Cost))
+		{
+			GoalCosts.Add(Portal, Cost);
+		}
+	}
+
+	if (StartEdges.Num() == 0 || GoalCosts.Num() == 0)
+		return false;
+
+	// Noeuds: portails, puis départ et arrivée virtuels
+	const int32 StartNode = m_Portals.Num();
+	const int32 GoalNode = StartNode + 1;
+
+	auto NodeLocation = [&](int32 Node) -> const FVector&
+	{
+		return Node == StartNode ? Start : (Node == GoalNode ? End : m_Portals[Node].Location);
+	};
+
+	TArray<float> G;
+	G.Init(FLT_MAX, GoalNode + 1);
+	TArray<int32> Parent;
+	Parent.Init(INDEX_NONE, GoalNode + 1);
+
+	TArray<FSDTOpenPortal> Open;
+	G[StartNode] = 0.f;
+	Open.HeapPush({ StartNode, 0.f, FVector::Dist(Start, End) }, FSDTOpenPortalPredicate());
+
+	auto Relax = [&](int32 From, int32 To, float Cost)
+	{
+		const float NewG = G[From] + Cost;
+		if (NewG < G[To])
+		{
+			G[To] = NewG;
+			Parent[To] = From;
+			Open.HeapPush({ To, NewG, NewG + FVector::Dist(NodeLocation(To), End) }, FSDTOpenPortalPredicate());
+		}
+	};
+
+	// Un cluster dont les coûts sont en cours de calcul n'offre aucune arête
+	auto RelaxCluster = [&](int32 Node, int32 Cluster, int32 Local)
+	{
+		const FCluster& Data = m_Clusters[Cluster];
+		if (Data.bEdgesReady)
+		{
+			for (const FPortalEdge& Edge : Data.Edges[Local])
+			{
+				Relax(Node, Edge.To, Edge.Cost);
+			}
+		}
+	};
+
+	while (Open.Num() > 0)
+	{
+		FSDTOpenPortal Current;
+		Open.HeapPop(Current, FSDTOpenPortalPredicate());
+
+		if (Current.Node == GoalNode)
+			break;
+
+		if (Current.G > G[Current.Node])
+			continue;
+
+		if (Current.Node == StartNode)
+		{
+			for (const FPortalEdge& Edge : StartEdges)
+			{
+				Relax(StartNode, Edge.To, Edge.Cost);
+			}
+			continue;
+		}
+
+		const FPortal& Portal = m_Portals[Current.Node];
+		RelaxCluster(Current.Node, Portal.ClusterA, Portal.LocalA);
+		RelaxCluster(Current.Node, Portal.ClusterB, Portal.LocalB);
+
+		if (const float* GoalCost = GoalCosts.Find(Current.Node))
+		{
+			Relax(Current.Node, GoalNode, *GoalCost);
+		}
+	}
+
+	if (Parent[GoalNode] == INDEX_NONE)
+		return false;
+
+	for (int32 Node = GoalNode; Node != StartNode; Node = Parent[Node])
+	{
+		OutWaypoints.Add(NodeLocation(Node));
+	}
+	Algo::Reverse(OutWaypoints);
+
+	return OutWaypoints.Num() > 1;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTHierarchicalPathSubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ * Couche de recherche de chemin hiérarchique (type HPA*) au-dessus du navmesh Recast.
+ * Le navmesh est découpé en clusters carrés; les portails sont les passages navigables sur les
+ * frontières entre clusters, et le coût portail-portail à l'intérieur d'un cluster est précalculé
+ * (longueur de chemin réelle).
+ *
+ * Ce précalcul est étalé sur plusieurs frames (MaxEdgeQueriesPerTick requêtes par tick). Après une
+ * modification du navmesh, seuls les clusters touchés par les zones sales sont recalculés; un cluster
+ * en cours de calcul n'offre aucune arête, la requête retombe alors sur le chemin classique.
+ *
+ * Une longue requête devient un A* sur quelques centaines de portails; seul le premier tronçon est
+ * calculé en détail, les suivants sont raffinés paresseusement par USDTPathFollowingComponent,
+ * un segment avant que l'agent ne l'atteigne.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTHierarchicalPathSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Chemin abstrait Start -> End: suite de portails puis End. Retourne false si la requête est assez
+	 * courte (ou dans le même cluster) pour qu'une requête classique soit préférable.
+	 * Les liens départ -> portail et portail -> arrivée sont vérifiés sur le navmesh.
+	 */
+	bool FindAbstractPath(const FVector& Start, const FVector& End, TArray<FVector>& OutWaypoints) const;
+
+	// Reconstruit toute la couche: portails tout de suite, coûts internes étalés sur les ticks suivants
+	void Rebuild();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	void OnNavigationDirtied(const FBox& DirtyBounds);
+
+	UPROPERTY(Config)
+	float ClusterSize = 3000.f;
+
+	// Espacement des échantillons le long d'une frontière pour détecter les passages
+	UPROPERTY(Config)
+	float PortalSampleSpacing = 150.f;
+
+	// En dessous de cette distance, la requête classique est utilisée
+	UPROPERTY(Config)
+	float MinHierarchicalDistance = 6000.f;
+
+	// Requêtes de longueur de chemin faites par tick pour les coûts internes des clusters
+	UPROPERTY(Config)
+	int32 MaxEdgeQueriesPerTick = 16;
+
+private:
+	struct FPortal
+	{
+		FVector Location;
+		int32 ClusterA;
+		int32 ClusterB;
+		// Position du portail dans FCluster::Portals de chacun de ses deux clusters
+		int32 LocalA;
+		int32 LocalB;
+	};
+
+	struct FPortalEdge
+	{
+		int32 To;
+		float Cost;
+	};
+
+	struct FCluster
+	{
+		TArray<int32> Portals;
+		// Parallèle à Portals: arêtes vers les autres portails du cluster
+		TArray<TArray<FPortalEdge>> Edges;
+		bool bEdgesReady = false;
+	};
+
+	int32 GetClusterIndex(const FVector& Location) const;
+	const ANavigationData* GetNavData() const;
+
+	// Frontière +X (pair) ou +Y (impair) du cluster Border / 2
+	void SampleBorder(int32 Border);
+	void RefreshClusterPortals(int32 Cluster);
+	void QueueCluster(int32 Cluster);
+
+	// Coût local From -> To: raycast navmesh, sinon longueur de chemin bornée. False si injoignable localement.
+	bool GetLocalCost(const ANavigationData& NavData, const FVector& From, const FVector& To, float& OutCost) const;
+
+	FVector m_Origin = FVector::ZeroVector;
+	float m_CenterZ = 0.f;
+	float m_ProjectionHalfHeight = 0.f;
+	FIntPoint m_ClusterCount = FIntPoint::ZeroValue;
+	FBox m_NavBounds = FBox(ForceInit);
+
+	TArray<FPortal> m_Portals;
+	TArray<int32> m_FreePortals;
+	TArray<TArray<int32>> m_BorderPortals;
+	TArray<FCluster> m_Clusters;
+
+	// Clusters dont les coûts internes restent à calculer; le premier est en cours (paire m_BuildI, m_BuildJ)
+	TArray<int32> m_PendingClusters;
+	int32 m_BuildI = 0;
+	int32 m_BuildJ = 1;
+	double m_BuildStartTime = 0.0;
+
+	// Zones salies depuis la dernière génération, appliquées quand les tuiles sont reconstruites
+	TArray<FBox> m_DirtyBounds;
+	FDelegateHandle m_NavigationDirtiedHandle;
+};
@@ -0,0 +1,144 @@
+#include "SDTInstancedMeshSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+
+void USDTInstancedMeshSubsystem::Deinitialize()
+{
+	m_Components.Empty();
+	m_InstanceTransforms.Empty();
+	m_HiddenInstances.Empty();
+	m_FreeInstances.Empty();
+	m_HostActor = nullptr;
+	Super::Deinitialize();
+}
+
+bool USDTInstancedMeshSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 USDTInstancedMeshSubsystem::FindOrCreateComponent(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	for (int32 i = 0; i < m_Components.Num(); ++i)
+	{
+		if (m_Components[i]->GetStaticMesh() == Mesh && m_Components[i]->GetMaterial(0) == Material)
+			return i;
+	}
+
+	if (!m_HostActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		m_HostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		m_HostActor->SetRootComponent(NewObject<USceneComponent>(m_HostActor, TEXT("Root")));
+		m_HostActor->GetRootComponent()->RegisterComponent();
+	}
+
+	// Rendu uniquement: la logique (touches, ramassage) ne passe pas par la physique de l'ISM
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(m_HostActor);
+	Component->SetStaticMesh(Mesh);
+	if (Material)
+	{
+		Component->SetMaterial(0, Material);
+	}
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetGenerateOverlapEvents(false);
+	Component->SetMobility(EComponentMobility::Movable);
+	Component->SetupAttachment(m_HostActor->GetRootComponent());
+	Component->RegisterComponent();
+
+	m_InstanceTransforms.AddDefaulted();
+	m_HiddenInstances.AddDefaulted();
+	m_FreeInstances.AddDefaulted();
+	return m_Components.Add(Component);
+}
+
+FSDTInstanceHandle USDTInstancedMeshSubsystem::AddInstance(UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform)
+{
+	FSDTInstanceHandle Handle;
+	if (!Mesh)
+		return Handle;
+
+	Handle.Component = FindOrCreateComponent(Mesh, Material);
+
+	// Réutilise une instance libérée plutôt que de faire grossir l'ISM
+	TArray<int32>& FreeInstances = m_FreeInstances[Handle.Component];
+	if (FreeInstances.Num() > 0)
+	{
+		Handle.Instance = FreeInstances.Pop();
+		m_InstanceTransforms[Handle.Component][Handle.Instance] = Transform;
+		m_HiddenInstances[Handle.Component][Handle.Instance] = false;
+		UpdateInstance(Handle, true);
+		return Handle;
+	}
+
+	Handle.Instance = m_Components[Handle.Component]->AddInstance(Transform, true);
+
+	m_InstanceTransforms[Handle.Component].Add(Transform);
+	m_HiddenInstances[Handle.Component].Add(false);
+	return Handle;
+}
+
+void USDTInstancedMeshSubsystem::RemoveInstance(FSDTInstanceHandle& Handle)
+{
+	if (!Handle.IsValid() || !m_Components.IsValidIndex(Handle.Component))
+		return;
+
+	SetInstanceHidden(Handle, true);
+	m_FreeInstances[Handle.Component].Add(Handle.Instance);
+	Handle = FSDTInstanceHandle();
+}
+
+void USDTInstancedMeshSubsystem::UpdateInstance(const FSDTInstanceHandle& Handle, bool bMarkRenderStateDirty)
+{
+	FTransform Transform = m_InstanceTransforms[Handle.Component][Handle.Instance];
+	if (m_HiddenInstances[Handle.Component][Handle.Instance])
+	{
+		Transform.SetScale3D(FVector::ZeroVector);
+	}
+
+	m_Components[Handle.Component]->UpdateInstanceTransform(Handle.Instance, Transform, true, bMarkRenderStateDirty, true);
+}
+
+void USDTInstancedMeshSubsystem::SetInstanceLocation(const FSDTInstanceHandle& Handle, const FVector& Location)
+{
+	if (!Handle.IsValid())
+		return;
+
+	m_InstanceTransforms[Handle.Component][Handle.Instance].SetLocation(Location);
+	UpdateInstance(Handle, true);
+}
+
+void USDTInstancedMeshSubsystem::SetInstanceHidden(const FSDTInstanceHandle& Handle, bool bHidden)
+{
+	if (!Handle.IsValid() || m_HiddenInstances[Handle.Component][Handle.Instance] == bHidden)
+		return;
+
+	m_HiddenInstances[Handle.Component][Handle.Instance] = bHidden;
+	UpdateInstance(Handle, true);
+}
+
+void USDTInstancedMeshSubsystem::BatchSetInstanceLocations(TArrayView<const FSDTInstanceHandle> Handles, TArrayView<const FVector> Locations)
+{
+	check(Handles.Num() == Locations.Num());
+
+	TBitArray<> DirtyComponents(false, m_Components.Num());
+
+	for (int32 i = 0; i < Handles.Num(); ++i)
+	{
+		const FSDTInstanceHandle& Handle = Handles[i];
+		if (!Handle.IsValid())
+			continue;
+
+		m_InstanceTransforms[Handle.Component][Handle.Instance].SetLocation(Locations[i]);
+		UpdateInstance(Handle, false);
+		DirtyComponents[Handle.Component] = true;
+	}
+
+	for (TConstSetBitIterator<> It(DirtyComponents); It; ++It)
+	{
+		m_Components[It.GetIndex()]->MarkRenderStateDirty();
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTInstancedMeshSubsystem.generated.h"
+
+class UStaticMesh;
+class UMaterialInterface;
+class UInstancedStaticMeshComponent;
+
+// Instance d'un maillage partagé: composant ISM + index d'instance dans ce composant
+struct FSDTInstanceHandle
+{
+	int32 Component = INDEX_NONE;
+	int32 Instance = INDEX_NONE;
+
+	bool IsValid() const { return Component != INDEX_NONE && Instance != INDEX_NONE; }
+};
+
+/**
+ * Rendu instancié des entités denses (projectiles, collectibles): un UInstancedStaticMeshComponent
+ * par couple maillage/matériau, porté par un acteur hôte unique. Les entités logiques sont adressées
+ * par FSDTInstanceHandle. Les instances ne sont jamais retirées de l'ISM (les index restent stables):
+ * une instance libérée est masquée puis réutilisée par le prochain AddInstance sur le même composant.
+ */
+UCLASS()
+class SOFTDESIGNTRAINING_API USDTInstancedMeshSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	FSDTInstanceHandle AddInstance(UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform);
+
+	// Libère l'instance (masquée, puis réutilisée); le handle est invalidé
+	void RemoveInstance(FSDTInstanceHandle& Handle);
+
+	void SetInstanceLocation(const FSDTInstanceHandle& Handle, const FVector& Location);
+	void SetInstanceHidden(const FSDTInstanceHandle& Handle, bool bHidden);
+
+	// Met à jour un lot d'instances; l'état de rendu n'est invalidé qu'une fois par composant
+	void BatchSetInstanceLocations(TArrayView<const FSDTInstanceHandle> Handles, TArrayView<const FVector> Locations);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	int32 FindOrCreateComponent(UStaticMesh* Mesh, UMaterialInterface* Material);
+	void UpdateInstance(const FSDTInstanceHandle& Handle, bool bMarkRenderStateDirty);
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> m_HostActor;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> m_Components;
+
+	// Transform logique de chaque instance (une instance masquée est rendue à l'échelle zéro)
+	TArray<TArray<FTransform>> m_InstanceTransforms;
+	TArray<TBitArray<>> m_HiddenInstances;
+
+	// Instances libérées de chaque composant, réutilisées par AddInstance
+	TArray<TArray<int32>> m_FreeInstances;
+};
@@ -0,0 +1,237 @@
+#include "SDTNavGrid.h"
+#include "SoftDesignTraining.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+
+namespace
+{
+	struct FSDTOpenCell
+	{
+		int32 Index;
+		float Cost;
+	};
+
+	struct FSDTOpenCellPredicate
+	{
+		bool operator()(const FSDTOpenCell& A, const FSDTOpenCell& B) const { return A.Cost < B.Cost; }
+	};
+
+	// Directions des voisins: bit i du masque d'une cellule = Offsets[i]; la direction opposée est i ^ 1
+	const FIntPoint Offsets[8] = {
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(-1, -1), FIntPoint(1, -1), FIntPoint(-1, 1)
+	};
+
+	int32 GetDirection(const FIntPoint& Offset)
+	{
+		for (int32 i = 0; i < 8; ++i)
+		{
+			if (Offsets[i] == Offset)
+				return i;
+		}
+		return INDEX_NONE;
+	}
+}
+
+bool FSDTNavGrid::Build(UWorld* World, float InCellSize, float InMaxStepHeight)
+{
+	Reset();
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys)
+		return false;
+
+	const ANavigationData* NavData = NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate);
+	if (!NavData)
+		return false;
+
+	const FBox Bounds = NavData->GetBounds();
+	if (!Bounds.IsValid)
+		return false;
+
+	CellSize = FMath::Max(InCellSize, 10.f);
+	MaxStepHeight = InMaxStepHeight;
+	Origin = Bounds.Min;
+
+	const FVector Size = Bounds.GetSize();
+	Dimensions.X = FMath::Max(1, FMath::CeilToInt(Size.X / CellSize));
+	Dimensions.Y = FMath::Max(1, FMath::CeilToInt(Size.Y / CellSize));
+
+	CellLocations.SetNumUninitialized(Num());
+	Walkable.Init(false, Num());
+	NeighbourMasks.Init(0, Num());
+
+	// Projection d'une cellule: on reste dans son empreinte XY, mais on couvre toute la hauteur du navmesh
+	const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, Size.Z * 0.5f + 50.f);
+	const float CenterZ = Bounds.GetCenter().Z;
+
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		const FIntPoint Cell = GetCell(Index);
+		const FVector Center(Origin.X + (Cell.X + 0.5f) * CellSize, Origin.Y + (Cell.Y + 0.5f) * CellSize, CenterZ);
+
+		FNavLocation Projected;
+		if (NavSys->ProjectPointToNavigation(Center, Projected, Extent, NavData))
+		{
+			CellLocations[Index] = Projected.Location;
+			Walkable[Index] = true;
+		}
+		else
+		{
+			CellLocations[Index] = Center;
+		}
+	}
+
+	// Une cellule qui touche à peine le navmesh est navigable: seul un raycast navmesh entre les points
+	// projetés prouve que deux voisines sont reliées (pas à travers un mur plus mince qu'une cellule)
+	const FSharedConstNavQueryFilter Filter = NavData->GetDefaultQueryFilter();
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		if (!Walkable[Index])
+			continue;
+
+		// Directions paires seulement; l'opposée est écrite chez le voisin
+		for (int32 Direction = 0; Direction < 8; Direction += 2)
+		{
+			const int32 Neighbour = GetIndex(GetCell(Index) + Offsets[Direction]);
+			if (Neighbour == INDEX_NONE || !Walkable[Neighbour] ||
+				FMath::Abs(CellLocations[Index].Z - CellLocations[Neighbour].Z) > MaxStepHeight)
+				continue;
+
+			FVector HitLocation;
+			if (!NavData->Raycast(CellLocations[Index], CellLocations[Neighbour], HitLocation, Filter))
+			{
+				NeighbourMasks[Index] |= 1 << Direction;
+				NeighbourMasks[Neighbour] |= 1 << (Direction ^ 1);
+			}
+		}
+	}
+
+	UE_LOG(LogSoftDesignTraining, Log, TEXT("FSDTNavGrid: %dx%d cellules de %.0f"), Dimensions.X, Dimensions.Y, CellSize);
+	return true;
+}
+
+void FSDTNavGrid::Reset()
+{
+	Dimensions = FIntPoint::ZeroValue;
+	CellLocations.Reset();
+	Walkable.Reset();
+	NeighbourMasks.Reset();
+}
+
+int32 FSDTNavGrid::GetIndex(const FVector& Location) const
+{
+	if (!IsValid())
+		return INDEX_NONE;
+
+	const FIntPoint Cell(FMath::FloorToInt((Location.X - Origin.X) / CellSize), FMath::FloorToInt((Location.Y - Origin.Y) / CellSize));
+	return GetIndex(Cell);
+}
+
+int32 FSDTNavGrid::GetIndex(const FIntPoint& Cell) const
+{
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= Dimensions.X || Cell.Y >= Dimensions.Y)
+		return INDEX_NONE;
+
+	return Cell.Y * Dimensions.X + Cell.X;
+}
+
+bool FSDTNavGrid::CanTraverse(int32 From, int32 To) const
+{
+	if (!IsWalkable(From) || !IsWalkable(To))
+		return false;
+
+	const int32 Direction = GetDirection(GetCell(To) - GetCell(From));
+	return Direction != INDEX_NONE && (NeighbourMasks[From] & (1 << Direction)) != 0;
+}
+
+int32 FSDTNavGrid::GetNeighbours(int32 Index, int32 OutNeighbours[8], float OutCosts[8]) const
+{
+	const FIntPoint Cell = GetCell(Index);
+	const uint8 Mask = IsWalkable(Index) ? NeighbourMasks[Index] : 0;
+	int32 Count = 0;
+
+	for (int32 i = 0; i < 8; ++i)
+	{
+		if ((Mask & (1 << i)) == 0)
+			continue;
+
+		const int32 Neighbour = GetIndex(Cell + Offsets[i]);
+
+		const bool bDiagonal = (i >= 4);
+		if (bDiagonal)
+		{
+			// Pas de coupe de coin: les deux cellules orthogonales doivent être praticables
+			const int32 SideA = GetIndex(FIntPoint(Cell.X + Offsets[i].X, Cell.Y));
+			const int32 SideB = GetIndex(FIntPoint(Cell.X, Cell.Y + Offsets[i].Y));
+			if (!CanTraverse(Index, SideA) || !CanTraverse(Index, SideB))
+				continue;
+		}
+
+		OutNeighbours[Count] = Neighbour;
+		OutCosts[Count] = bDiagonal ? CellSize * UE_SQRT_2 : CellSize;
+		++Count;
+	}
+
+	return Count;
+}
+
+void FSDTNavGrid::ComputeIntegrationField(int32 GoalIndex, TArray<float>& OutCosts, float MaxCost) const
+{
+	OutCosts.Init(FLT_MAX, Num());
+
+	TArray<int32> Touched;
+	UpdateIntegrationField(GoalIndex, OutCosts, Touched, MaxCost);
+}
+
+void FSDTNavGrid::UpdateIntegrationField(int32 GoalIndex, TArray<float>& InOutCosts, TArray<int32>& InOutTouched, float MaxCost) const
+{
+	if (InOutCosts.Num() != Num())
+	{
+		InOutCosts.Init(FLT_MAX, Num());
+	}
+	else
+	{
+		for (const int32 Index : InOutTouched)
+		{
+			InOutCosts[Index] = FLT_MAX;
+		}
+	}
+	InOutTouched.Reset();
+
+	if (!IsWalkable(GoalIndex))
+		return;
+
+	TArray<FSDTOpenCell> Open;
+	Open.HeapPush({ GoalIndex, 0.f }, FSDTOpenCellPredicate());
+	InOutCosts[GoalIndex] = 0.f;
+	InOutTouched.Add(GoalIndex);
+
+	int32 Neighbours[8];
+	float StepCosts[8];
+
+	while (Open.Num() > 0)
+	{
+		FSDTOpenCell Current;
+		Open.HeapPop(Current, FSDTOpenCellPredicate());
+
+		// Entrée périmée (une meilleure valeur a déjà été trouvée)
+		if (Current.Cost > InOutCosts[Current.Index])
+			continue;
+
+		const int32 Count = GetNeighbours(Current.Index, Neighbours, StepCosts);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const float NewCost = Current.Cost + StepCosts[i];
+			if (NewCost < InOutCosts[Neighbours[i]] && NewCost <= MaxCost)
+			{
+				if (InOutCosts[Neighbours[i]] == FLT_MAX)
+				{
+					InOutTouched.Add(Neighbours[i]);
+				}
+				InOutCosts[Neighbours[i]] = NewCost;
+				Open.HeapPush({ Neighbours[i], NewCost }, FSDTOpenCellPredicate());
+			}
+		}
+	}
+}
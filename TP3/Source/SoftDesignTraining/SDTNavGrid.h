@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * Grille 2D régulière posée sur le navmesh (une cellule par colonne, adapté aux cartes vues de dessus).
+ * Chaque cellule est projetée une seule fois sur la navigation à la construction; ensuite toutes les
+ * requêtes (index, voisins, champ d'intégration) sont de simples accès tableau.
+ * Partagée par les sous-systèmes qui ont besoin d'un champ sur la zone navigable.
+ */
+struct SOFTDESIGNTRAINING_API FSDTNavGrid
+{
+public:
+	// Construit la grille sur les bornes du navmesh par défaut. Retourne false si aucune navigation n'existe.
+	bool Build(UWorld* World, float InCellSize, float InMaxStepHeight = 100.f);
+	void Reset();
+
+	bool IsValid() const { return Dimensions.X > 0 && Dimensions.Y > 0; }
+	int32 Num() const { return Dimensions.X * Dimensions.Y; }
+	float GetCellSize() const { return CellSize; }
+	const FVector& GetOrigin() const { return Origin; }
+	const FIntPoint& GetDimensions() const { return Dimensions; }
+
+	// INDEX_NONE si hors grille
+	int32 GetIndex(const FVector& Location) const;
+	int32 GetIndex(const FIntPoint& Cell) const;
+	FIntPoint GetCell(int32 Index) const { return FIntPoint(Index % Dimensions.X, Index / Dimensions.X); }
+
+	bool IsWalkable(int32 Index) const { return Walkable.IsValidIndex(Index) && Walkable[Index]; }
+
+	// Position de la cellule projetée sur le navmesh (centre XY si non navigable)
+	const FVector& GetCellLocation(int32 Index) const { return CellLocations[Index]; }
+
+	// Vrai si on peut passer de A à B (voisins directs, marche acceptable, raycast navmesh libre à la construction).
+	bool CanTraverse(int32 From, int32 To) const;
+
+	// Voisins 8-connexes (sans couper les coins bloqués). Retourne le nombre de voisins écrits.
+	int32 GetNeighbours(int32 Index, int32 OutNeighbours[8], float OutCosts[8]) const;
+
+	/**
+	 * Dijkstra depuis la cellule But. OutCosts reçoit la distance (unités monde) pour chaque cellule,
+	 * FLT_MAX si non atteinte. MaxCost borne la propagation (utile pour les champs locaux).
+	 */
+	void ComputeIntegrationField(int32 GoalIndex, TArray<float>& OutCosts, float MaxCost = FLT_MAX) const;
+
+	/**
+	 * Variante incrémentale: InOutCosts doit déjà valoir FLT_MAX partout sauf sur les cellules de InOutTouched,
+	 * qui sont remises à FLT_MAX avant la propagation. InOutTouched reçoit ensuite les cellules atteintes.
+	 * Le coût est proportionnel à la zone couverte par MaxCost, pas à la taille de la grille.
+	 */
+	void UpdateIntegrationField(int32 GoalIndex, TArray<float>& InOutCosts, TArray<int32>& InOutTouched, float MaxCost) const;
+
+private:
+	FVector Origin = FVector::ZeroVector;
+	float CellSize = 100.f;
+	float MaxStepHeight = 100.f;
+	FIntPoint Dimensions = FIntPoint::ZeroValue;
+
+	TArray<FVector> CellLocations;
+	TBitArray<> Walkable;
+	// Un bit par direction (8-connexe): arête vers le voisin validée une fois à la construction
+	TArray<uint8> NeighbourMasks;
+};
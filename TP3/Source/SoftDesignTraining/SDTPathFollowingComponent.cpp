@@ -5,6 +5,10 @@
 #include "SDTUtils.h"
 #include "SDTAIController.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavMesh/NavMeshPath.h"
+#include "SDTFlowFieldSubsystem.h"
 
 #include "DrawDebugHelpers.h"
 
@@ -13,6 +17,161 @@ USDTPathFollowingComponent::USDTPathFollowingComponent(const FObjectInitializer&
 
 }
 
+FAIRequestID USDTPathFollowingComponent::RequestMove(const FAIMoveRequest& RequestData, FNavPathSharedPtr InPath)
+{
+    if (InPath.IsValid())
+    {
+        SimplifyPath(*InPath);
+    }
+
+    const bool bFlowFieldPath = m_PendingFlowFieldPath;
+    m_PendingFlowFieldPath = false;
+
+    // Super interrompt le déplacement précédent (OnPathFinished libère alors le champ): on reprend la main après
+    const FAIRequestID RequestID = Super::RequestMove(RequestData, InPath);
+
+    if (bFlowFieldPath && RequestID.IsValid())
+    {
+        if (!m_IsFlowFieldConsumer)
+        {
+            if (USDTFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<USDTFlowFieldSubsystem>())
+            {
+                FlowField->AddConsumer();
+                m_IsFlowFieldConsumer = true;
+            }
+        }
+        m_FollowsFlowField = m_IsFlowFieldConsumer;
+    }
+    else
+    {
+        ReleaseFlowField();
+    }
+
+    return RequestID;
+}
+
+bool USDTPathFollowingComponent::MakeFlowFieldPath(const FAIMoveRequest& RequestData, const FPathFindingQuery& Query, FNavPathSharedPtr& OutPath)
+{
+    USDTFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<USDTFlowFieldSubsystem>();
+    const AActor* GoalActor = RequestData.GetGoalActor();
+    if (!FlowField || !GoalActor || !FlowField->HasGoal() || !Query.NavData.IsValid() ||
+        FVector::Dist2D(GoalActor->GetActorLocation(), FlowField->GetGoalLocation()) > FlowField->GetCellSize() * 2.f)
+    {
+        return false;
+    }
+
+    // Le premier consommateur force le calcul du champ s'il est périmé
+    const bool bWasConsumer = m_IsFlowFieldConsumer;
+    if (!bWasConsumer)
+    {
+        FlowField->AddConsumer();
+        m_IsFlowFieldConsumer = true;
+    }
+
+    TArray<FVector> Points;
+    if (!FlowField->GetFlowPath(Query.StartLocation, Points))
+    {
+        if (!bWasConsumer)
+        {
+            ReleaseFlowField();
+        }
+        return false;
+    }
+
+    FNavPathSharedPtr NavPath = MakeShareable(new FNavMeshPath());
+    for (const FVector& Point : Points)
+    {
+        NavPath->GetPathPoints().Add(FNavPathPoint(Point));
+    }
+    NavPath->SetNavigationDataUsed(const_cast<ANavigationData*>(Query.NavData.Get()));
+    NavPath->SetQueryData(Query);
+    NavPath->EnableRecalculationOnInvalidation(true);
+    NavPath->MarkReady();
+
+    OutPath = NavPath;
+    m_PendingFlowFieldPath = true;
+    m_FlowFieldVersion = FlowField->GetFieldVersion();
+    return true;
+}
+
+void USDTPathFollowingComponent::RefreshFlowFieldPath()
+{
+    if (!m_FollowsFlowField || Status != EPathFollowingStatus::Moving || !Path.IsValid() || !NavMovementInterface.IsValid())
+    {
+        return;
+    }
+
+    const USDTFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<USDTFlowFieldSubsystem>();
+    if (!FlowField || FlowField->GetFieldVersion() == m_FlowFieldVersion)
+    {
+        return;
+    }
+    m_FlowFieldVersion = FlowField->GetFieldVersion();
+
+    // Hors du nouveau champ: on garde l'ancien chemin jusqu'au prochain recalcul ou à la fin du Move To
+    TArray<FVector> Points;
+    if (!FlowField->GetFlowPath(NavMovementInterface->GetFeetLocation(), Points))
+    {
+        return;
+    }
+
+    TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+    PathPoints.Reset(Points.Num());
+    for (const FVector& Point : Points)
+    {
+        PathPoints.Add(FNavPathPoint(Point));
+    }
+
+    // Même chemin mis à jour: le suivi repart du début via OnPathUpdated
+    Path->DoneUpdating(ENavPathUpdateType::GoalMoved);
+}
+
+void USDTPathFollowingComponent::ReleaseFlowField()
+{
+    if (m_IsFlowFieldConsumer)
+    {
+        if (USDTFlowFieldSubsystem* FlowField = GetWorld() ? GetWorld()->GetSubsystem<USDTFlowFieldSubsystem>() : nullptr)
+        {
+            FlowField->RemoveConsumer();
+        }
+    }
+
+    m_IsFlowFieldConsumer = false;
+    m_FollowsFlowField = false;
+}
+
+void USDTPathFollowingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    RefreshFlowFieldPath();
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void USDTPathFollowingComponent::OnPathFinished(const FPathFollowingResult& Result)
+{
+    ReleaseFlowField();
+
+    Super::OnPathFinished(Result);
+}
+
+void USDTPathFollowingComponent::OnPathUpdated()
+{
+    // Le chemin mis à jour est suivi depuis son début recalculé après cet appel
+    if (Path.IsValid())
+    {
+        SimplifyPath(*Path);
+    }
+
+    Super::OnPathUpdated();
+}
+
+void USDTPathFollowingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ReleaseFlowField();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void USDTPathFollowingComponent::FollowPathSegment(float DeltaTime)
 {
     if (!Path.IsValid() || !NavMovementInterface.IsValid())
@@ -113,8 +272,22 @@ void USDTPathFollowingComponent::FollowPathSegment(float DeltaTime)
 
 void USDTPathFollowingComponent::SetMoveSegment(int32 SegmentStartIndex)
 {
+    // Le segment qui commence doit être détaillé; le suivant est raffiné un segment à l'avance.
+    // Sans chemin vérifié jusqu'au but, le déplacement échoue plutôt que de couper en ligne droite.
+    if (!RefineHierarchicalPortal(SegmentStartIndex + 1))
+    {
+        OnPathFinished(FPathFollowingResult(EPathFollowingResult::Aborted, FPathFollowingResultFlags::InvalidPath));
+        return;
+    }
+
     Super::SetMoveSegment(SegmentStartIndex);
 
+    if (!RefineHierarchicalPortal(MoveSegmentStartIndex + 2))
+    {
+        OnPathFinished(FPathFollowingResult(EPathFollowingResult::Aborted, FPathFollowingResultFlags::InvalidPath));
+        return;
+    }
+
     const TArray<FNavPathPoint>& points = Path->GetPathPoints();
 
     const FNavPathPoint& SegmentStart = points[MoveSegmentStartIndex];
@@ -166,3 +339,129 @@ void USDTPathFollowingComponent::SetMoveSegment(int32 SegmentStartIndex)
     }
 }
 
+bool USDTPathFollowingComponent::RefineHierarchicalPortal(int32 PointIndex)
+{
+    if (!Path.IsValid())
+    {
+        return true;
+    }
+
+    TArray<FNavPathPoint>& points = Path->GetPathPoints();
+    if (PointIndex <= 0 || !points.IsValidIndex(PointIndex) || !SDTUtils::IsHierarchicalPortal(points[PointIndex]))
+    {
+        return true;
+    }
+
+    UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const ANavigationData* navData = Path->GetNavigationDataUsed();
+    if (!navSys || !navData)
+    {
+        return false;
+    }
+
+    FPathFindingQuery query(GetOwner(), *navData, points[PointIndex - 1].Location, points[PointIndex].Location, Path->GetFilter());
+    FPathFindingResult result = navSys->FindPathSync(query);
+
+    // Portail injoignable: chemin complet vers la vraie destination, qui remplace tout le reste de l'abstrait
+    int32 numReplaced = 1;
+    if (!result.IsSuccessful() || !result.Path.IsValid() || result.Path->GetPathPoints().Num() < 2)
+    {
+        query.EndLocation = Path->GetQueryData().EndLocation;
+        result = navSys->FindPathSync(query);
+        numReplaced = points.Num() - PointIndex;
+
+        if (!result.IsSuccessful() || !result.Path.IsValid() || result.Path->GetPathPoints().Num() < 2 || result.IsPartial())
+        {
+            return false;
+        }
+    }
+
+    // Le premier point du tronçon est le point précédent, déjà dans le chemin
+    TArray<FNavPathPoint>& detailedPoints = result.Path->GetPathPoints();
+    if (bSimplifyPath)
+    {
+        SimplifyPathPoints(detailedPoints, *navData, Path->GetFilter());
+    }
+
+    points.RemoveAt(PointIndex, numReplaced);
+    points.Insert(&detailedPoints[1], detailedPoints.Num() - 1, PointIndex);
+
+    DecelerationSegmentIndex += detailedPoints.Num() - 1 - numReplaced;
+    return true;
+}
+
+void USDTPathFollowingComponent::SimplifyPath(FNavigationPath& InPath) const
+{
+    if (bSimplifyPath && InPath.GetNavigationDataUsed())
+    {
+        SimplifyPathPoints(InPath.GetPathPoints(), *InPath.GetNavigationDataUsed(), InPath.GetFilter());
+    }
+}
+
+void USDTPathFollowingComponent::SimplifyPathPoints(TArray<FNavPathPoint>& Points, const ANavigationData& NavData, FSharedConstNavQueryFilter Filter) const
+{
+    if (Points.Num() < 3)
+    {
+        return;
+    }
+
+    // Un segment de nav link / saut se définit par son point de départ (marqué) et le point suivant
+    auto isSegmentLocked = [&Points](int32 index)
+    {
+        return SDTUtils::IsNavLink(Points[index]) || SDTUtils::HasJumpFlag(Points[index]);
+    };
+
+    auto isAnchor = [&](int32 index)
+    {
+        return index == Points.Num() - 1
+            || isSegmentLocked(index)
+            || isSegmentLocked(index - 1)
+            || SDTUtils::IsHierarchicalPortal(Points[index]);
+    };
+
+    auto canSkipTo = [&](int32 from, int32 to)
+    {
+        const FVector& start = Points[from].Location;
+        const FVector& end = Points[to].Location;
+
+        bool bCollinear = true;
+        for (int32 i = from + 1; i < to && bCollinear; ++i)
+        {
+            bCollinear = FMath::PointDistToSegment(Points[i].Location, start, end) <= SimplifyCollinearTolerance;
+        }
+
+        if (bCollinear)
+        {
+            return true;
+        }
+
+        FVector hitLocation;
+        return !NavData.Raycast(start, end, hitLocation, Filter, GetOwner());
+    };
+
+    TArray<FNavPathPoint> simplified;
+    simplified.Reserve(Points.Num());
+    simplified.Add(Points[0]);
+
+    int32 current = 0;
+    while (current < Points.Num() - 1)
+    {
+        int32 next = current + 1;
+
+        if (!isSegmentLocked(current))
+        {
+            while (!isAnchor(next) && canSkipTo(current, next + 1))
+            {
+                ++next;
+            }
+        }
+
+        simplified.Add(Points[next]);
+        current = next;
+    }
+
+    if (simplified.Num() < Points.Num())
+    {
+        Points = MoveTemp(simplified);
+    }
+}
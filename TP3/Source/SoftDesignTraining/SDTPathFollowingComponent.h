@@ -6,6 +6,8 @@
 #include "Navigation/PathFollowingComponent.h"
 #include "SDTPathFollowingComponent.generated.h"
 
+class ANavigationData;
+
 /**
 *
 */
@@ -18,6 +20,48 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = AI)
         float m_JumpProgressRatio = 0.f;
 
+    // Post-traitement du chemin avant le suivi (requête et mises à jour): moins de points = moins de
+    // transitions SetMoveSegment, au prix de raycasts navmesh à chaque chemin. Désactivé par défaut.
+    UPROPERTY(EditAnywhere, Config, Category = AI)
+        bool bSimplifyPath = false;
+
+    // Écart maximal (cm) d'un point à la droite de ses voisins pour être fusionné sans raycast
+    UPROPERTY(EditAnywhere, Config, Category = AI)
+        float SimplifyCollinearTolerance = 10.f;
+
+    virtual FAIRequestID RequestMove(const FAIMoveRequest& RequestData, FNavPathSharedPtr InPath) override;
     virtual void FollowPathSegment(float DeltaTime) override;
     virtual void SetMoveSegment(int32 SegmentStartIndex) override;
+    virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /**
+     * Poursuite de la cible du champ de flux (Move To sur le joueur): le chemin est lu dans
+     * USDTFlowFieldSubsystem au lieu d'une requête A*, puis reconstruit à chaque recalcul du champ.
+     * False si le but n'est pas la cible du champ ou si le départ est hors du champ.
+     */
+    bool MakeFlowFieldPath(const FAIMoveRequest& RequestData, const FPathFindingQuery& Query, FNavPathSharedPtr& OutPath);
+
+protected:
+    virtual void OnPathFinished(const FPathFollowingResult& Result) override;
+    // Repath, but déplacé, navigation modifiée et chemin du champ de flux reconstruit
+    virtual void OnPathUpdated() override;
+
+    void ReleaseFlowField();
+    void RefreshFlowFieldPath();
+
+    // Fusionne les points colinéaires et raccourcit par raycast navmesh; nav links, sauts et portails sont conservés
+    void SimplifyPathPoints(TArray<FNavPathPoint>& Points, const ANavigationData& NavData, FSharedConstNavQueryFilter Filter) const;
+    void SimplifyPath(FNavigationPath& InPath) const;
+
+    // Remplace un portail hiérarchique par le chemin détaillé depuis le point précédent, ou à défaut par un
+    // chemin complet jusqu'au but. False si aucun des deux n'existe: le chemin ne peut plus être suivi.
+    bool RefineHierarchicalPortal(int32 PointIndex);
+
+private:
+    // Chemin courant construit depuis le champ de flux, et version du champ utilisée
+    bool m_IsFlowFieldConsumer = false;
+    bool m_FollowsFlowField = false;
+    bool m_PendingFlowFieldPath = false;
+    int32 m_FlowFieldVersion = INDEX_NONE;
 };
\ No newline at end of file
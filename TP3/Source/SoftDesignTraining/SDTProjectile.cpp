@@ -2,22 +2,23 @@
 
 #include "SDTProjectile.h"
 #include "SoftDesignTraining.h"
+#include "SDTProjectileSubsystem.h"
 
 ASDTProjectile::ASDTProjectile()
 {
-    PrimaryActorTick.bCanEverTick = true;
-    PrimaryActorTick.bStartWithTickEnabled = true;
+    // Déplacement simulé en lot par USDTProjectileSubsystem
+    PrimaryActorTick.bCanEverTick = false;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
-void ASDTProjectile::Tick(float deltaTime)
+void ASDTProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(deltaTime);
-
-    if (m_Fired)
+    if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
     {
-        FVector impulse = m_Direction * m_Speed * deltaTime;
-        SetActorLocation(GetActorLocation() + impulse);
+        projectiles->UnregisterProjectile(this);
     }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ASDTProjectile::FireProjectile(const FVector& direction, float speed)
@@ -26,10 +27,27 @@ void ASDTProjectile::FireProjectile(const FVector& direction, float speed)
     m_Speed = speed;
 
     m_Fired = true;
-    m_StartingPosition = GetActorLocation();
+
+    if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
+    {
+        projectiles->RegisterProjectile(this, m_Direction * m_Speed);
+    }
+}
+
+void ASDTProjectile::OnReleasedToPool()
+{
+    m_Fired = false;
+
+    if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
+    {
+        projectiles->UnregisterProjectile(this);
+    }
 }
 
 void ASDTProjectile::ResetProjectile()
 {
-    SetActorLocation(m_StartingPosition);
-}
\ No newline at end of file
+    if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
+    {
+        projectiles->ResetProjectile(this);
+    }
+}
@@ -4,31 +4,36 @@
 
 #include "CoreMinimal.h"
 #include "Engine/StaticMeshActor.h"
+#include "SDTActorPoolSubsystem.h"
 #include "SDTProjectile.generated.h"
 
 /**
  * 
  */
 UCLASS()
-class SOFTDESIGNTRAINING_API ASDTProjectile : public AStaticMeshActor
+class SOFTDESIGNTRAINING_API ASDTProjectile : public AStaticMeshActor, public ISDTPoolable
 {
 	GENERATED_BODY()
 
 public:
     ASDTProjectile();
 
-    virtual void Tick(float deltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     void FireProjectile(const FVector& direction, float speed);
     void ResetProjectile();
 
+    // ISDTPoolable
+    virtual void OnReleasedToPool() override;
+
 protected:
     float m_Speed;
     FVector m_Direction;
 
-    UPROPERTY(EditAnywhere)
-        float m_TimeToLive = 5.f;
-
     bool m_Fired = false;
-    FVector m_StartingPosition;
+
+private:
+    // Index dans USDTProjectileSubsystem (le déplacement est simulé là-bas)
+    friend class USDTProjectileSubsystem;
+    int32 m_SimulationIndex = INDEX_NONE;
 };
@@ -2,6 +2,10 @@
 
 #include "SDTProjectileSpawner.h"
 #include "SoftDesignTraining.h"
+#include "SDTProjectileSubsystem.h"
+#include "SDTInstancedMeshSubsystem.h"
+#include "SDTActorPoolSubsystem.h"
+#include "Engine/StaticMesh.h"
 
 #include "Engine/World.h"
 #include "TimerManager.h"
@@ -15,12 +19,43 @@ void ASDTProjectileSpawner::BeginPlay()
 {
     Super::BeginPlay();
 
+    if (!m_UseInstancedProjectiles)
+    {
+        if (USDTActorPoolSubsystem* pool = GetWorld()->GetSubsystem<USDTActorPoolSubsystem>())
+        {
+            pool->Prewarm(m_SDTProjectileBP, m_MaxSimultaneousProjectiles, GetActorTransform());
+        }
+    }
+
     //shoot a projectile on spawn
     FireProjectile();
 
     GetWorldTimerManager().SetTimer(m_ShotCooldownTimer, this, &ASDTProjectileSpawner::OnReadyToShoot, m_TimeToShoot, true);
 }
 
+void ASDTProjectileSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
+    {
+        for (int32 id : m_InstancedProjectiles)
+        {
+            projectiles->RemoveInstancedProjectile(id);
+        }
+    }
+    m_InstancedProjectiles.Empty();
+
+    if (USDTActorPoolSubsystem* pool = GetWorld()->GetSubsystem<USDTActorPoolSubsystem>())
+    {
+        for (ASDTProjectile* projectile : m_Projectiles)
+        {
+            pool->Release(projectile);
+        }
+    }
+    m_Projectiles.Empty();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ASDTProjectileSpawner::OnReadyToShoot()
 {
     FireProjectile();
@@ -28,7 +63,30 @@ void ASDTProjectileSpawner::OnReadyToShoot()
 
 void ASDTProjectileSpawner::FireProjectile()
 {
-    if (m_Projectiles.Num() >= m_MaxSimultaneousProjectiles)
+    if (m_UseInstancedProjectiles)
+    {
+        FireInstancedProjectile();
+        return;
+    }
+
+    USDTActorPoolSubsystem* pool = GetWorld()->GetSubsystem<USDTActorPoolSubsystem>();
+    if (pool)
+    {
+        // File FIFO: le plus ancien projectile retourne au pool et en ressort au point de tir
+        if (m_Projectiles.Num() >= m_MaxSimultaneousProjectiles)
+        {
+            pool->Release(m_Projectiles[0]);
+            m_Projectiles.RemoveAt(0);
+        }
+
+        ASDTProjectile* projectile = pool->Acquire<ASDTProjectile>(m_SDTProjectileBP, GetActorTransform());
+        if (projectile)
+        {
+            m_Projectiles.Add(projectile);
+            projectile->FireProjectile(m_ShotDirection, m_ShotSpeed);
+        }
+    }
+    else if (m_Projectiles.Num() >= m_MaxSimultaneousProjectiles)
     {
         ResetOldestProjectile();
     }
@@ -41,12 +99,51 @@ void ASDTProjectileSpawner::FireProjectile()
     }
 }
 
+void ASDTProjectileSpawner::FireInstancedProjectile()
+{
+    USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>();
+    USDTInstancedMeshSubsystem* instanced = GetWorld()->GetSubsystem<USDTInstancedMeshSubsystem>();
+    if (!projectiles || !instanced || !m_SDTProjectileBP)
+        return;
+
+    if (m_InstancedProjectiles.Num() >= m_MaxSimultaneousProjectiles)
+    {
+        ResetOldestProjectile();
+        return;
+    }
+
+    // Maillage, matériau et échelle pris sur les valeurs par défaut du blueprint de projectile
+    const UStaticMeshComponent* meshComponent = m_SDTProjectileBP->GetDefaultObject<ASDTProjectile>()->GetStaticMeshComponent();
+    UStaticMesh* mesh = meshComponent->GetStaticMesh();
+    if (!mesh)
+        return;
+
+    const FVector scale = meshComponent->GetRelativeScale3D();
+    const FTransform transform(GetActorRotation(), GetActorLocation(), scale);
+    const float radius = mesh->GetBounds().SphereRadius * scale.GetMax();
+
+    const FSDTInstanceHandle instance = instanced->AddInstance(mesh, meshComponent->GetMaterial(0), transform);
+    m_InstancedProjectiles.Add(projectiles->AddInstancedProjectile(instance, GetActorLocation(), m_ShotDirection * m_ShotSpeed, radius));
+}
+
 void ASDTProjectileSpawner::ResetOldestProjectile()
 {
-    m_Projectiles[m_OldestProjectileIndex]->ResetProjectile();
+    const int32 numProjectiles = m_UseInstancedProjectiles ? m_InstancedProjectiles.Num() : m_Projectiles.Num();
+
+    if (m_UseInstancedProjectiles)
+    {
+        if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
+        {
+            projectiles->ResetInstancedProjectile(m_InstancedProjectiles[m_OldestProjectileIndex]);
+        }
+    }
+    else
+    {
+        m_Projectiles[m_OldestProjectileIndex]->ResetProjectile();
+    }
     ++m_OldestProjectileIndex;
 
-    if (m_OldestProjectileIndex >= m_Projectiles.Num())
+    if (m_OldestProjectileIndex >= numProjectiles)
         m_OldestProjectileIndex = 0;
 }
 
@@ -21,9 +21,11 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     void OnReadyToShoot();
     void FireProjectile();
+    void FireInstancedProjectile();
     void ResetOldestProjectile();
 
     UPROPERTY(EditDefaultsOnly, Category = "ActorSpawning")
@@ -41,7 +43,13 @@ protected:
     UPROPERTY(EditAnywhere)
         int32 m_MaxSimultaneousProjectiles = 5;
 
+    // Projectiles sans acteur, rendus par instance (USDTInstancedMeshSubsystem)
+    UPROPERTY(EditAnywhere)
+        bool m_UseInstancedProjectiles = false;
+
     FTimerHandle m_ShotCooldownTimer;
     TArray<ASDTProjectile*> m_Projectiles;
+    // Identifiants USDTProjectileSubsystem des projectiles instanciés
+    TArray<int32> m_InstancedProjectiles;
     int32 m_OldestProjectileIndex = 0;
 };
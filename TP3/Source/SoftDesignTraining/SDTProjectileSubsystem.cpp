@@ -0,0 +1,311 @@
+#include "SDTProjectileSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "SDTProjectile.h"
+#include "SoftDesignTrainingCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Async/ParallelFor.h"
+
+void USDTProjectileSubsystem::Deinitialize()
+{
+	m_Projectiles.Empty();
+	m_Positions.Empty();
+	m_Velocities.Empty();
+	m_StartPositions.Empty();
+	m_Radii.Empty();
+	m_HitCapsules.Empty();
+	m_Instances.Empty();
+	m_EntryIds.Empty();
+	m_IdToIndex.Empty();
+	m_FreeIds.Empty();
+	m_NumInstanced = 0;
+	m_Characters.Empty();
+	m_CapsuleOwners.Empty();
+	m_CapsuleHash.Reset(HashCellSize);
+	Super::Deinitialize();
+}
+
+bool USDTProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTProjectileSubsystem, STATGROUP_Tickables);
+}
+
+void USDTProjectileSubsystem::RegisterProjectile(ASDTProjectile* Projectile, const FVector& Velocity)
+{
+	if (!Projectile)
+		return;
+
+	if (Projectile->m_SimulationIndex != INDEX_NONE)
+	{
+		m_Velocities[Projectile->m_SimulationIndex] = Velocity;
+		return;
+	}
+
+	const FVector Location = Projectile->GetActorLocation();
+	float Radius = 0.f;
+
+	if (UStaticMeshComponent* Mesh = Projectile->GetStaticMeshComponent())
+	{
+		Radius = Mesh->Bounds.SphereRadius;
+
+		if (bAnalyticHits)
+		{
+			Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			Mesh->SetGenerateOverlapEvents(false);
+		}
+	}
+
+	Projectile->m_SimulationIndex = m_Positions.Num();
+	AddEntry(Projectile, FSDTInstanceHandle(), INDEX_NONE, Location, Velocity, Radius);
+}
+
+void USDTProjectileSubsystem::AddEntry(ASDTProjectile* Projectile, const FSDTInstanceHandle& Instance, int32 Id, const FVector& Location, const FVector& Velocity, float Radius)
+{
+	m_Projectiles.Add(Projectile);
+	m_Positions.Add(Location);
+	m_Velocities.Add(Velocity);
+	m_StartPositions.Add(Location);
+	m_Radii.Add(Radius);
+	m_Instances.Add(Instance);
+	m_EntryIds.Add(Id);
+}
+
+int32 USDTProjectileSubsystem::AddInstancedProjectile(const FSDTInstanceHandle& Instance, const FVector& Location, const FVector& Velocity, float Radius)
+{
+	const int32 Id = m_FreeIds.Num() > 0 ? m_FreeIds.Pop() : m_IdToIndex.AddUninitialized();
+	m_IdToIndex[Id] = m_Positions.Num();
+
+	AddEntry(nullptr, Instance, Id, Location, Velocity, Radius);
+	++m_NumInstanced;
+	return Id;
+}
+
+void USDTProjectileSubsystem::ResetInstancedProjectile(int32 Id)
+{
+	if (!m_IdToIndex.IsValidIndex(Id) || m_IdToIndex[Id] == INDEX_NONE)
+		return;
+
+	const int32 Index = m_IdToIndex[Id];
+	m_Positions[Index] = m_StartPositions[Index];
+
+	if (USDTInstancedMeshSubsystem* Instanced = GetWorld()->GetSubsystem<USDTInstancedMeshSubsystem>())
+	{
+		Instanced->SetInstanceLocation(m_Instances[Index], m_Positions[Index]);
+	}
+}
+
+void USDTProjectileSubsystem::RemoveInstancedProjectile(int32 Id)
+{
+	if (!m_IdToIndex.IsValidIndex(Id) || m_IdToIndex[Id] == INDEX_NONE)
+		return;
+
+	const int32 Index = m_IdToIndex[Id];
+	if (USDTInstancedMeshSubsystem* Instanced = GetWorld()->GetSubsystem<USDTInstancedMeshSubsystem>())
+	{
+		// L'instance retourne dans la liste libre du composant
+		Instanced->RemoveInstance(m_Instances[Index]);
+	}
+
+	RemoveAt(Index);
+}
+
+void USDTProjectileSubsystem::UnregisterProjectile(ASDTProjectile* Projectile)
+{
+	if (Projectile && m_Projectiles.IsValidIndex(Projectile->m_SimulationIndex) && m_Projectiles[Projectile->m_SimulationIndex] == Projectile)
+	{
+		RemoveAt(Projectile->m_SimulationIndex);
+	}
+}
+
+void USDTProjectileSubsystem::ResetProjectile(ASDTProjectile* Projectile)
+{
+	if (!Projectile || !m_Projectiles.IsValidIndex(Projectile->m_SimulationIndex))
+		return;
+
+	const int32 Index = Projectile->m_SimulationIndex;
+	m_Positions[Index] = m_StartPositions[Index];
+	Projectile->SetActorLocation(m_Positions[Index]);
+}
+
+void USDTProjectileSubsystem::RemoveAt(int32 Index)
+{
+	if (IsValid(m_Projectiles[Index]))
+	{
+		m_Projectiles[Index]->m_SimulationIndex = INDEX_NONE;
+	}
+
+	if (m_EntryIds[Index] != INDEX_NONE)
+	{
+		m_IdToIndex[m_EntryIds[Index]] = INDEX_NONE;
+		m_FreeIds.Add(m_EntryIds[Index]);
+		--m_NumInstanced;
+	}
+
+	m_Projectiles.RemoveAtSwap(Index);
+	m_Positions.RemoveAtSwap(Index);
+	m_Velocities.RemoveAtSwap(Index);
+	m_StartPositions.RemoveAtSwap(Index);
+	m_Radii.RemoveAtSwap(Index);
+	m_Instances.RemoveAtSwap(Index);
+	m_EntryIds.RemoveAtSwap(Index);
+
+	// Le dernier élément a pris la place de l'élément retiré
+	if (m_Positions.IsValidIndex(Index))
+	{
+		if (IsValid(m_Projectiles[Index]))
+		{
+			m_Projectiles[Index]->m_SimulationIndex = Index;
+		}
+		if (m_EntryIds[Index] != INDEX_NONE)
+		{
+			m_IdToIndex[m_EntryIds[Index]] = Index;
+		}
+	}
+}
+
+void USDTProjectileSubsystem::RegisterCharacter(ASoftDesignTrainingCharacter* Character)
+{
+	if (Character)
+	{
+		m_Characters.AddUnique(Character);
+	}
+}
+
+void USDTProjectileSubsystem::UnregisterCharacter(ASoftDesignTrainingCharacter* Character)
+{
+	m_Characters.RemoveSingleSwap(Character);
+}
+
+void USDTProjectileSubsystem::BuildCapsuleHash()
+{
+	m_CapsuleOwners.Reset();
+	m_CapsuleHash.Reset(HashCellSize);
+
+	for (ASoftDesignTrainingCharacter* Character : m_Characters)
+	{
+		if (const UCapsuleComponent* Capsule = IsValid(Character) ? Character->GetCapsuleComponent() : nullptr)
+		{
+			m_CapsuleHash.Add(*Capsule);
+			m_CapsuleOwners.Add(Character);
+		}
+	}
+
+	m_CapsuleHash.Finalize();
+}
+
+int32 USDTProjectileSubsystem::FindFirstHit(const FVector& From, const FVector& To, float Radius) const
+{
+	const FVector Extent(Radius, Radius, 0.f);
+
+	int32 BestCapsule = INDEX_NONE;
+	float BestDistance = FLT_MAX;
+
+	m_CapsuleHash.ForEachCandidate(From.ComponentMin(To) - Extent, From.ComponentMax(To) + Extent, [&](int32 Capsule)
+	{
+		// Sphère balayée contre capsule: distance entre le segment parcouru et l'axe de la capsule
+		FVector OnPath;
+		const float HitRadius = Radius + m_CapsuleHash.GetRadius(Capsule);
+		if (m_CapsuleHash.DistSquaredToSegment(Capsule, From, To, OnPath) <= FMath::Square(HitRadius))
+		{
+			const float Distance = FVector::DistSquared(From, OnPath);
+			if (Distance < BestDistance)
+			{
+				BestDistance = Distance;
+				BestCapsule = Capsule;
+			}
+		}
+	});
+
+	return BestCapsule;
+}
+
+void USDTProjectileSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Projectiles détruits hors de notre contrôle (fin de niveau, GC)
+	for (int32 i = m_Projectiles.Num() - 1; i >= 0; --i)
+	{
+		if (m_EntryIds[i] == INDEX_NONE && !IsValid(m_Projectiles[i]))
+		{
+			RemoveAt(i);
+		}
+	}
+
+	const int32 Count = m_Positions.Num();
+	if (Count == 0)
+		return;
+
+	const bool bTestHits = bAnalyticHits && m_Characters.Num() > 0;
+	if (bTestHits)
+	{
+		BuildCapsuleHash();
+	}
+
+	m_HitCapsules.SetNumUninitialized(Count);
+
+	FVector* Positions = m_Positions.GetData();
+	const FVector* Velocities = m_Velocities.GetData();
+	const float* Radii = m_Radii.GetData();
+	int32* HitCapsules = m_HitCapsules.GetData();
+
+	ParallelFor(Count, [this, Positions, Velocities, Radii, HitCapsules, DeltaTime, bTestHits](int32 Index)
+	{
+		const FVector From = Positions[Index];
+		const FVector To = From + Velocities[Index] * DeltaTime;
+
+		Positions[Index] = To;
+		HitCapsules[Index] = bTestHits ? FindFirstHit(From, To, Radii[Index]) : INDEX_NONE;
+	}, Count < 64);
+
+	// Projectiles acteurs: avec les touches analytiques, le transform du composant racine est écrit
+	// directement (ni sweep, ni physique, ni overlap); sinon les overlaps font les touches et restent nécessaires
+	if (m_NumInstanced < Count)
+	{
+		for (int32 i = 0; i < Count; ++i)
+		{
+			ASDTProjectile* Projectile = m_Projectiles[i];
+			if (!Projectile)
+				continue;
+
+			USceneComponent* Root = Projectile->GetRootComponent();
+			if (bAnalyticHits && Root)
+			{
+				Root->SetWorldLocationAndRotationNoPhysics(m_Positions[i], Root->GetComponentRotation());
+			}
+			else
+			{
+				Projectile->SetActorLocation(m_Positions[i]);
+			}
+		}
+	}
+
+	// Projectiles instanciés: un seul lot pour tout le monde
+	if (m_NumInstanced > 0)
+	{
+		if (USDTInstancedMeshSubsystem* Instanced = GetWorld()->GetSubsystem<USDTInstancedMeshSubsystem>())
+		{
+			Instanced->BatchSetInstanceLocations(m_Instances, m_Positions);
+		}
+	}
+
+	if (!bTestHits)
+		return;
+
+	// Die() téléporte le personnage: une seule mort par personnage et par frame
+	TBitArray<> Killed(false, m_CapsuleOwners.Num());
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const int32 Capsule = m_HitCapsules[i];
+		if (Capsule != INDEX_NONE && !Killed[Capsule])
+		{
+			Killed[Capsule] = true;
+			m_CapsuleOwners[Capsule]->Die();
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTInstancedMeshSubsystem.h"
+#include "SDTCapsuleHash.h"
+#include "SDTProjectileSubsystem.generated.h"
+
+class ASDTProjectile;
+class ASoftDesignTrainingCharacter;
+
+/**
+ * Simulation centralisée de tous les projectiles tirés par les ASDTProjectileSpawner.
+ * Positions et vitesses sont stockées en structure de tableaux; l'intégration se fait en une passe
+ * ParallelFor, puis les transforms sont écrits sur le game thread: un seul BatchSetInstanceLocations
+ * en mode instancié; pour les projectiles acteurs, une passe qui écrit le transform du composant racine
+ * sans physique ni overlap quand les touches sont analytiques. Les projectiles eux-mêmes ne tickent plus.
+ *
+ * Les touches sont analytiques: chaque déplacement est un segment balayé (sphère) testé contre les
+ * capsules des personnages, rangées dans une table de hachage spatiale reconstruite chaque frame.
+ * La collision physique des projectiles est alors coupée (plus d'overlaps dynamiques).
+ *
+ * En mode instancié, un projectile n'est plus un acteur: c'est une entrée de simulation avec une
+ * instance de USDTInstancedMeshSubsystem, adressée par un identifiant stable.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterProjectile(ASDTProjectile* Projectile, const FVector& Velocity);
+	void UnregisterProjectile(ASDTProjectile* Projectile);
+
+	// Ramène le projectile à sa position de tir (il continue avec la même vitesse)
+	void ResetProjectile(ASDTProjectile* Projectile);
+
+	// Projectile sans acteur. Retourne un identifiant stable (les index de simulation changent).
+	int32 AddInstancedProjectile(const FSDTInstanceHandle& Instance, const FVector& Location, const FVector& Velocity, float Radius);
+	void ResetInstancedProjectile(int32 Id);
+	void RemoveInstancedProjectile(int32 Id);
+
+	int32 Num() const { return m_Positions.Num(); }
+
+	void RegisterCharacter(ASoftDesignTrainingCharacter* Character);
+	void UnregisterCharacter(ASoftDesignTrainingCharacter* Character);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// Touches calculées ici plutôt que par overlap physique (COLLISION_DEATH_OBJECT)
+	UPROPERTY(Config)
+	bool bAnalyticHits = true;
+
+	// Taille des cellules de la table de hachage des capsules
+	UPROPERTY(Config)
+	float HashCellSize = 500.f;
+
+private:
+	void AddEntry(ASDTProjectile* Projectile, const FSDTInstanceHandle& Instance, int32 Id, const FVector& Location, const FVector& Velocity, float Radius);
+	void RemoveAt(int32 Index);
+	void BuildCapsuleHash();
+	int32 FindFirstHit(const FVector& From, const FVector& To, float Radius) const;
+
+	// Acteur de chaque entrée (nul pour les entrées instanciées)
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ASDTProjectile>> m_Projectiles;
+
+	TArray<FVector> m_Positions;
+	TArray<FVector> m_Velocities;
+	TArray<FVector> m_StartPositions;
+	TArray<float> m_Radii;
+	TArray<int32> m_HitCapsules;
+
+	// Entrées instanciées: handle d'instance et identifiant stable (INDEX_NONE pour les acteurs)
+	TArray<FSDTInstanceHandle> m_Instances;
+	TArray<int32> m_EntryIds;
+	TArray<int32> m_IdToIndex;
+	TArray<int32> m_FreeIds;
+	int32 m_NumInstanced = 0;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ASoftDesignTrainingCharacter>> m_Characters;
+
+	// Capsules de la frame, indexées comme m_CapsuleOwners
+	TArray<ASoftDesignTrainingCharacter*> m_CapsuleOwners;
+	FSDTCapsuleHash m_CapsuleHash;
+};
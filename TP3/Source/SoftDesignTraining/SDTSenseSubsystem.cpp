@@ -0,0 +1,397 @@
+#include "SDTSenseSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "SDTUtils.h"
+#include "SDTFleeLocation.h"
+#include "SDTCollectible.h"
+#include "SDTFlowFieldSubsystem.h"
+#include "SDTThreatMapSubsystem.h"
+#include "SDTVisibilitySubsystem.h"
+#include "SoftDesignTrainingGameMode.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+#include "Async/ParallelFor.h"
+#include "DrawDebugHelpers.h"
+#include "EngineUtils.h"
+
+namespace
+{
+	// Clés du Blackboard (doivent correspondre exactement aux clés du BB)
+	const FName KEY_PlayerActor(TEXT("PlayerActor"));
+	const FName KEY_HasLOS(TEXT("HasLOS"));
+	const FName KEY_IsPlayerPoweredUp(TEXT("IsPlayerPoweredUp"));
+	const FName KEY_LKP(TEXT("LKP"));
+	const FName KEY_LKPValidUntil(TEXT("LKPValidUntil"));
+	const FName KEY_TargetLocation(TEXT("TargetLocation"));
+}
+
+void USDTSenseSubsystem::Deinitialize()
+{
+	m_Requests.Empty();
+	m_Results.Empty();
+	m_Snapshot = FWorldSnapshot();
+	Super::Deinitialize();
+}
+
+bool USDTSenseSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTSenseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTSenseSubsystem, STATGROUP_Tickables);
+}
+
+void USDTSenseSubsystem::QueueSense(const FSDTSenseRequest& Request)
+{
+	m_Requests.Add(Request);
+}
+
+void USDTSenseSubsystem::Tick(float DeltaTime)
+{
+	const int32 Count = m_Requests.Num();
+	if (Count == 0)
+		return;
+
+	// Phase 1: collecte sur le game thread
+	GatherSnapshot();
+
+	if (!m_Snapshot.Player.IsValid())
+	{
+		for (const FSDTSenseRequest& Request : m_Requests)
+		{
+			if (UBlackboardComponent* BB = Request.Blackboard.Get())
+			{
+				BB->ClearValue(KEY_PlayerActor);
+			}
+		}
+		m_Requests.Reset();
+		return;
+	}
+
+	for (FSDTSenseRequest& Request : m_Requests)
+	{
+		APawn* Pawn = Request.Pawn.Get();
+		UBlackboardComponent* BB = Request.Blackboard.Get();
+		Request.bValid = Pawn && BB;
+		if (Request.bValid)
+		{
+			Request.SelfLocation = Pawn->GetActorLocation();
+			Request.Forward = Pawn->GetActorForwardVector();
+			Request.LKP = BB->GetValueAsVector(KEY_LKP);
+			Request.LKPValidUntil = BB->GetValueAsFloat(KEY_LKPValidUntil);
+		}
+	}
+
+	m_Results.Reset();
+	m_Results.SetNum(Count);
+
+	const FSDTSenseRequest* Requests = m_Requests.GetData();
+	FSenseResult* Results = m_Results.GetData();
+	const bool bSingleThread = Count < MinParallelAgents;
+
+	// Phase 2a: détection et LOS (PVS, sinon trace physique), en parallèle
+	ParallelFor(Count, [this, Requests, Results](int32 Index)
+	{
+		Detect(Requests[Index], Results[Index]);
+	}, bSingleThread);
+
+	// Phase 2b: décision, en parallèle
+	const int32 FrameSeed = ++m_FrameSeed;
+	ParallelFor(Count, [this, Requests, Results, FrameSeed](int32 Index)
+	{
+		Decide(Requests[Index], static_cast<int32>(HashCombine(FrameSeed, Index)), Results[Index]);
+	}, bSingleThread);
+
+	// Phase 3: application des commandes sur le game thread
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Apply(m_Requests[Index], m_Results[Index]);
+	}
+
+	m_Requests.Reset();
+}
+
+void USDTSenseSubsystem::GatherSnapshot()
+{
+	UWorld* World = GetWorld();
+	m_Snapshot = FWorldSnapshot();
+
+	ACharacter* PlayerChar = UGameplayStatics::GetPlayerCharacter(World, 0);
+	if (!PlayerChar)
+		return;
+
+	m_Snapshot.Player = PlayerChar;
+	m_Snapshot.PlayerLocation = PlayerChar->GetActorLocation();
+	if (const UCapsuleComponent* Capsule = PlayerChar->GetCapsuleComponent())
+	{
+		m_Snapshot.PlayerRadius = Capsule->GetScaledCapsuleRadius();
+		m_Snapshot.PlayerHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	}
+
+	m_Snapshot.bPoweredUp = SDTUtils::IsPlayerPoweredUp(World);
+	m_Snapshot.Now = World->GetTimeSeconds();
+	m_Snapshot.Visibility = World->GetSubsystem<USDTVisibilitySubsystem>();
+	m_Snapshot.ThreatMap = World->GetSubsystem<USDTThreatMapSubsystem>();
+	m_Snapshot.World = World;
+	m_Snapshot.LOSObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+
+	if (m_Snapshot.bPoweredUp)
+	{
+		for (TActorIterator<ASDTFleeLocation> It(World); It; ++It)
+		{
+			m_Snapshot.FleeLocations.Add(It->GetActorLocation());
+		}
+	}
+	else
+	{
+		for (TActorIterator<ASDTCollectible> It(World); It; ++It)
+		{
+			if (!It->IsOnCooldown())
+			{
+				m_Snapshot.AvailableCollectibles.Add(It->GetActorLocation());
+			}
+		}
+	}
+}
+
+void USDTSenseSubsystem::Detect(const FSDTSenseRequest& Request, FSenseResult& Result) const
+{
+	if (!Request.bValid)
+		return;
+
+	// Équivalent analytique du balayage de sphère vers l'avant contre la capsule du joueur
+	const FVector DetectionStart = Request.SelfLocation + Request.Forward * Request.DetectionForwardOffset;
+	const FVector DetectionEnd = DetectionStart + Request.Forward * Request.DetectionHalfLength * 2.f;
+
+	const FVector AxisOffset(0.f, 0.f, FMath::Max(0.f, m_Snapshot.PlayerHalfHeight - m_Snapshot.PlayerRadius));
+	FVector ClosestOnSweep, ClosestOnPlayer;
+	FMath::SegmentDistToSegmentSafe(DetectionStart, DetectionEnd, m_Snapshot.PlayerLocation - AxisOffset, m_Snapshot.PlayerLocation + AxisOffset, ClosestOnSweep, ClosestOnPlayer);
+
+	const float HitDistance = Request.DetectionRadius + m_Snapshot.PlayerRadius;
+	Result.bDetected = FVector::DistSquared(ClosestOnSweep, ClosestOnPlayer) <= FMath::Square(HitDistance);
+
+	// LOS seulement si le joueur a été détecté
+	if (!Result.bDetected)
+		return;
+
+	const ESDTVisibility Baked = m_Snapshot.Visibility
+		? m_Snapshot.Visibility->QueryVisibility(GetHeadLocation(Request.SelfLocation), GetHeadLocation(m_Snapshot.PlayerLocation))
+		: ESDTVisibility::Unknown;
+
+	// Paire prouvée visible ou occultée par le bake; seul Unknown passe par un vrai trace
+	Result.bHasLOS = Baked == ESDTVisibility::Unknown
+		? TraceLOS(GetHeadLocation(Request.SelfLocation), GetHeadLocation(m_Snapshot.PlayerLocation))
+		: Baked == ESDTVisibility::Visible;
+}
+
+void USDTSenseSubsystem::Decide(const FSDTSenseRequest& Request, int32 Seed, FSenseResult& Result) const
+{
+	if (!Request.bValid)
+		return;
+
+	if (m_Snapshot.bPoweredUp)
+	{
+		Result.State = ESenseState::Flee;
+		Result.bHasTarget = ChooseBestFleeLocation(Request.SelfLocation, Result.Target);
+	}
+	else if (Result.bHasLOS)
+	{
+		// Chase (LOS): Move To sur PlayerActor, pas besoin d'une TargetLocation
+		Result.State = ESenseState::Chase;
+		Result.bClearTarget = true;
+	}
+	else if (Request.LKPValidUntil > m_Snapshot.Now)
+	{
+		// Perte de vue: LKP encore valide
+		Result.State = ESenseState::Chase;
+		Result.bHasTarget = true;
+		Result.Target = Request.LKP;
+	}
+	else
+	{
+		// Collect (aléatoire parmi les collectibles hors cooldown)
+		Result.State = ESenseState::Collect;
+		if (m_Snapshot.AvailableCollectibles.Num() > 0)
+		{
+			const FRandomStream Random(Seed);
+			Result.bHasTarget = true;
+			Result.Target = m_Snapshot.AvailableCollectibles[Random.RandRange(0, m_Snapshot.AvailableCollectibles.Num() - 1)];
+		}
+	}
+}
+
+void USDTSenseSubsystem::Apply(const FSDTSenseRequest& Request, const FSenseResult& Result) const
+{
+	APawn* SelfPawn = Request.Pawn.Get();
+	UBlackboardComponent* BB = Request.Blackboard.Get();
+	if (!SelfPawn || !BB)
+		return;
+
+	UWorld* World = GetWorld();
+
+	BB->SetValueAsObject(KEY_PlayerActor, m_Snapshot.Player.Get());
+
+	// IsPlayerPoweredUp: utiliser Set/Clear pour supporter Decorator "Is Set"
+	if (m_Snapshot.bPoweredUp)
+	{
+		BB->SetValueAsBool(KEY_IsPlayerPoweredUp, true);
+	}
+	else
+	{
+		BB->ClearValue(KEY_IsPlayerPoweredUp);
+	}
+
+	if (Result.bHasLOS)
+	{
+		BB->SetValueAsBool(KEY_HasLOS, true);
+
+		// Refresh LKP quand LOS
+		BB->SetValueAsVector(KEY_LKP, m_Snapshot.PlayerLocation);
+		BB->SetValueAsFloat(KEY_LKPValidUntil, m_Snapshot.Now + Request.LKPValiditySeconds);
+
+		// LKP partagée: cible du champ de flux (recalculé seulement si le joueur change de cellule)
+		if (USDTFlowFieldSubsystem* FlowField = World->GetSubsystem<USDTFlowFieldSubsystem>())
+		{
+			FlowField->SetGoalLocation(m_Snapshot.PlayerLocation);
+		}
+	}
+	else
+	{
+		BB->ClearValue(KEY_HasLOS);
+	}
+
+	if (Result.bHasTarget)
+	{
+		BB->SetValueAsVector(KEY_TargetLocation, Result.Target);
+	}
+	else if (Result.bClearTarget)
+	{
+		BB->ClearValue(KEY_TargetLocation);
+	}
+
+	FString DebugState;
+	switch (Result.State)
+	{
+	case ESenseState::Flee:
+		DebugState = TEXT("Flee");
+		if (Request.bDrawDebug && Result.bHasTarget) DrawDebugSphere(World, Result.Target, 20.f, 12, FColor::Orange, false, Request.DebugDuration);
+		break;
+	case ESenseState::Chase:
+		DebugState = TEXT("Chase");
+		if (Request.bDrawDebug && Result.bHasTarget) DrawDebugSphere(World, Result.Target, 16.f, 8, FColor::Purple, false, Request.DebugDuration);
+		break;
+	case ESenseState::Collect:
+		DebugState = TEXT("Collect");
+		if (Request.bDrawDebug && Result.bHasTarget) DrawDebugSphere(World, Result.Target, 14.f, 8, FColor::Yellow, false, Request.DebugDuration);
+		break;
+	}
+
+	// Gestion du groupe (Partie 2) - tout ou rien:
+	// - Ajout si on entre en Chase (pas de retrait individuel)
+	// - Dissolution gérée par GameMode: PowerUp, mort, ou perte de vue de tous (timer)
+	if (ASoftDesignTrainingGameMode* GM = Cast<ASoftDesignTrainingGameMode>(World->GetAuthGameMode()))
+	{
+		if (Result.State == ESenseState::Chase)
+		{
+			GM->AddToChaseGroup(SelfPawn);
+		}
+
+		// Propager l'état de LOS de ce membre (utilisé pour dissoudre si plus aucun n'a la vue)
+		GM->UpdateChaseGroupLOS(SelfPawn, Result.bHasLOS);
+
+		// Affichage: sphère orange au-dessus des membres du groupe
+		if (GM->IsInChaseGroup(SelfPawn))
+		{
+			const FVector HeadPos = SelfPawn->GetActorLocation() + FVector(0.f, 0.f, 120.f);
+			DrawDebugSphere(World, HeadPos, 20.f, 12, FColor::Orange, false, Request.DebugDuration);
+		}
+	}
+
+	// Debug état au-dessus de la tête (comme legacy)
+	DrawDebugString(World, FVector(0.f, 0.f, 5.f), DebugState, SelfPawn, FColor::Orange, Request.DebugDuration, false);
+
+	// Option: dessiner la capsule de détection
+	if (Request.bDrawDebug)
+	{
+		const FVector DetectionStart = Request.SelfLocation + Request.Forward * Request.DetectionForwardOffset;
+		const FQuat Rot = SelfPawn->GetActorQuat() * SelfPawn->GetActorUpVector().ToOrientationQuat();
+		DrawDebugCapsule(World, DetectionStart + Request.DetectionHalfLength * Request.Forward, Request.DetectionHalfLength, Request.DetectionRadius, Rot, FColor::Blue, false, Request.DebugDuration);
+	}
+}
+
+bool USDTSenseSubsystem::TraceLOS(const FVector& From, const FVector& To) const
+{
+	// Appelé depuis les threads de travail: requête de lecture seule, sans lire le composant touché.
+	// To est dans la capsule du joueur, il est donc touché en premier si aucun obstacle statique ne coupe le segment.
+	return !m_Snapshot.World->LineTraceTestByObjectType(From, To, m_Snapshot.LOSObjectParams);
+}
+
+bool USDTSenseSubsystem::ChooseBestFleeLocation(const FVector& SelfLocation, FVector& OutLocation) const
+{
+	const FVector PlayerLoc = m_Snapshot.PlayerLocation;
+
+	FVector SelfToPlayer = PlayerLoc - SelfLocation;
+	SelfToPlayer.Normalize();
+
+	// Score legacy (distance au joueur + angle), sert de départage à menace égale
+	auto LegacyScore = [&](const FVector& FleeLoc)
+	{
+		const float Dist = FVector::Dist(FleeLoc, PlayerLoc);
+
+		FVector SelfToFlee = FleeLoc - SelfLocation;
+		SelfToFlee.Normalize();
+
+		const float AngleDeg = FMath::RadiansToDegrees(acosf(FVector::DotProduct(SelfToPlayer, SelfToFlee)));
+		return Dist + AngleDeg * 100.f;
+	};
+
+	// Carte de menace partagée: on prend la FleeLocation la moins menacée (lectures seulement)
+	const USDTThreatMapSubsystem* ThreatMap = m_Snapshot.ThreatMap;
+	if (ThreatMap && ThreatMap->IsThreatActive())
+	{
+		constexpr float ThreatTolerance = 0.05f;
+
+		float BestThreat = FLT_MAX;
+		float BestScore = -FLT_MAX;
+		bool bFound = false;
+
+		ThreatMap->ForEachFleeLocation([&](const FVector& FleeLoc, float Threat)
+		{
+			const bool bLessThreat = Threat < BestThreat - ThreatTolerance;
+			const bool bSameThreat = FMath::Abs(Threat - BestThreat) <= ThreatTolerance;
+			if (!bLessThreat && !bSameThreat)
+				return;
+
+			const float Score = LegacyScore(FleeLoc);
+			if (bLessThreat || Score > BestScore)
+			{
+				BestThreat = FMath::Min(BestThreat, Threat);
+				BestScore = Score;
+				OutLocation = FleeLoc;
+				bFound = true;
+			}
+		});
+
+		if (bFound)
+			return true;
+	}
+
+	float BestScore = -FLT_MAX;
+	bool bFound = false;
+
+	for (const FVector& FleeLoc : m_Snapshot.FleeLocations)
+	{
+		const float Score = LegacyScore(FleeLoc);
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			OutLocation = FleeLoc;
+			bFound = true;
+		}
+	}
+
+	return bFound;
+}
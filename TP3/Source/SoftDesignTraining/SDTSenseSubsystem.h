@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTSenseSubsystem.generated.h"
+
+class ACharacter;
+class UBlackboardComponent;
+class USDTThreatMapSubsystem;
+class USDTVisibilitySubsystem;
+
+// Ce que UBTService_SDT_Sense demande pour un agent, figé au moment du TickNode
+struct FSDTSenseRequest
+{
+	TWeakObjectPtr<UBlackboardComponent> Blackboard;
+	TWeakObjectPtr<APawn> Pawn;
+
+	// Paramètres du service et du contrôleur
+	float DetectionHalfLength = 500.f;
+	float DetectionRadius = 250.f;
+	float DetectionForwardOffset = 100.f;
+	float LKPValiditySeconds = 3.f;
+	float DebugDuration = 0.15f;
+	bool bDrawDebug = false;
+
+	// Instantané de l'agent (rempli par la phase de collecte)
+	FVector SelfLocation = FVector::ZeroVector;
+	FVector Forward = FVector::ForwardVector;
+	FVector LKP = FVector::ZeroVector;
+	float LKPValidUntil = 0.f;
+	// Pawn et Blackboard encore valides, résolu sur le game thread (les phases parallèles ne touchent pas aux UObject)
+	bool bValid = false;
+};
+
+/**
+ * Mise à jour de perception en deux phases pour tous les agents qui ont un service Sense.
+ * Les services ne font que déposer une requête; une fois tous les acteurs tickés, le service:
+ *  1. collecte (game thread) un instantané du monde et de chaque agent: joueur, capsule, PowerUp,
+ *     FleeLocations, collectibles disponibles, valeurs du Blackboard;
+ *  2. évalue en parallèle la détection (balayage analytique contre la capsule du joueur), la LOS
+ *     via le PVS, puis le choix d'état et de TargetLocation. Seules les LOS "Unknown" du PVS sont
+ *     tracées, depuis la même passe parallèle (les requêtes de lecture de la scène physique sont
+ *     thread-safe);
+ *  3. applique les commandes (Blackboard, champ de flux, groupe de poursuite, debug) sur le game thread.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTSenseSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void QueueSense(const FSDTSenseRequest& Request);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// En dessous, les phases parallèles restent sur le game thread
+	UPROPERTY(Config)
+	int32 MinParallelAgents = 16;
+
+private:
+	enum class ESenseState : uint8
+	{
+		Flee,
+		Chase,
+		Collect
+	};
+
+	struct FSenseResult
+	{
+		bool bDetected = false;
+		bool bHasLOS = false;
+		ESenseState State = ESenseState::Collect;
+		bool bHasTarget = false;
+		bool bClearTarget = false;
+		FVector Target = FVector::ZeroVector;
+	};
+
+	// Instantané du monde partagé par tous les agents de la frame (lecture seule en phase parallèle)
+	struct FWorldSnapshot
+	{
+		TWeakObjectPtr<ACharacter> Player;
+		FVector PlayerLocation = FVector::ZeroVector;
+		float PlayerRadius = 0.f;
+		float PlayerHalfHeight = 0.f;
+		bool bPoweredUp = false;
+		float Now = 0.f;
+		const USDTVisibilitySubsystem* Visibility = nullptr;
+		const USDTThreatMapSubsystem* ThreatMap = nullptr;
+		const UWorld* World = nullptr;
+		FCollisionObjectQueryParams LOSObjectParams;
+		TArray<FVector> FleeLocations;
+		TArray<FVector> AvailableCollectibles;
+	};
+
+	void GatherSnapshot();
+	void Detect(const FSDTSenseRequest& Request, FSenseResult& Result) const;
+	void Decide(const FSDTSenseRequest& Request, int32 Seed, FSenseResult& Result) const;
+	void Apply(const FSDTSenseRequest& Request, const FSenseResult& Result) const;
+
+	bool TraceLOS(const FVector& From, const FVector& To) const;
+	bool ChooseBestFleeLocation(const FVector& SelfLocation, FVector& OutLocation) const;
+
+	static FVector GetHeadLocation(const FVector& Location) { return Location + FVector(0.f, 0.f, 60.f); }
+
+	TArray<FSDTSenseRequest> m_Requests;
+	TArray<FSenseResult> m_Results;
+	FWorldSnapshot m_Snapshot;
+	int32 m_FrameSeed = 0;
+};
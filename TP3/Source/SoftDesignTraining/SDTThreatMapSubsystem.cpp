@@ -0,0 +1,153 @@
+#include "SDTThreatMapSubsystem.h"
+#include "SoftDesignTraining.h"
+#include "NavigationSystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/Character.h"
+
+#include "SDTFleeLocation.h"
+#include "SDTUtils.h"
+
+void USDTThreatMapSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &USDTThreatMapSubsystem::OnNavigationGenerationFinished);
+	}
+
+	RebuildGrid();
+}
+
+void USDTThreatMapSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &USDTThreatMapSubsystem::OnNavigationGenerationFinished);
+	}
+
+	m_Grid.Reset();
+	m_FleeLocations.Empty();
+	Super::Deinitialize();
+}
+
+bool USDTThreatMapSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTThreatMapSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTThreatMapSubsystem, STATGROUP_Tickables);
+}
+
+void USDTThreatMapSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	RebuildGrid();
+}
+
+void USDTThreatMapSubsystem::RebuildGrid()
+{
+	m_Grid.Build(GetWorld(), CellSize);
+
+	m_ThreatDistances.Reset();
+	m_TouchedCells.Reset();
+	m_ThreatCellIndex = INDEX_NONE;
+
+	for (FFleeLocationEntry& Entry : m_FleeLocations)
+	{
+		Entry.CellIndex = m_Grid.GetIndex(Entry.Location);
+		Entry.bWalkable = m_Grid.IsWalkable(Entry.CellIndex);
+		Entry.Threat = 0.f;
+	}
+}
+
+void USDTThreatMapSubsystem::RegisterFleeLocation(ASDTFleeLocation* FleeLocation)
+{
+	if (!FleeLocation)
+		return;
+
+	FFleeLocationEntry& Entry = m_FleeLocations.AddDefaulted_GetRef();
+	Entry.Actor = FleeLocation;
+	Entry.Location = FleeLocation->GetActorLocation();
+	Entry.CellIndex = m_Grid.GetIndex(Entry.Location);
+	Entry.bWalkable = m_Grid.IsWalkable(Entry.CellIndex);
+	Entry.Threat = GetThreatAtCell(Entry.CellIndex);
+}
+
+void USDTThreatMapSubsystem::UnregisterFleeLocation(ASDTFleeLocation* FleeLocation)
+{
+	m_FleeLocations.RemoveAllSwap([FleeLocation](const FFleeLocationEntry& Entry)
+	{
+		return !Entry.Actor.IsValid() || Entry.Actor.Get() == FleeLocation;
+	});
+}
+
+void USDTThreatMapSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	ACharacter* PlayerChar = UGameplayStatics::GetPlayerCharacter(World, 0);
+
+	if (!PlayerChar || !SDTUtils::IsPlayerPoweredUp(World))
+	{
+		ClearThreat();
+		return;
+	}
+
+	const int32 PlayerCellIndex = m_Grid.GetIndex(PlayerChar->GetActorLocation());
+	if (PlayerCellIndex != INDEX_NONE && PlayerCellIndex != m_ThreatCellIndex && m_Grid.IsWalkable(PlayerCellIndex))
+	{
+		UpdateThreat(PlayerCellIndex);
+	}
+}
+
+void USDTThreatMapSubsystem::UpdateThreat(int32 PlayerCellIndex)
+{
+	// Remet à zéro l'ancienne zone et propage depuis la nouvelle cellule (borné par ThreatRadius)
+	m_Grid.UpdateIntegrationField(PlayerCellIndex, m_ThreatDistances, m_TouchedCells, ThreatRadius);
+	m_ThreatCellIndex = PlayerCellIndex;
+
+	RefreshFleeLocationThreats();
+}
+
+void USDTThreatMapSubsystem::ClearThreat()
+{
+	if (m_ThreatCellIndex == INDEX_NONE)
+		return;
+
+	for (const int32 Index : m_TouchedCells)
+	{
+		m_ThreatDistances[Index] = FLT_MAX;
+	}
+	m_TouchedCells.Reset();
+	m_ThreatCellIndex = INDEX_NONE;
+
+	RefreshFleeLocationThreats();
+}
+
+void USDTThreatMapSubsystem::RefreshFleeLocationThreats()
+{
+	for (FFleeLocationEntry& Entry : m_FleeLocations)
+	{
+		Entry.Threat = GetThreatAtCell(Entry.CellIndex);
+	}
+}
+
+float USDTThreatMapSubsystem::GetThreatAtCell(int32 CellIndex) const
+{
+	if (m_ThreatCellIndex == INDEX_NONE || !m_ThreatDistances.IsValidIndex(CellIndex))
+		return 0.f;
+
+	const float Distance = m_ThreatDistances[CellIndex];
+	if (Distance == FLT_MAX)
+		return 0.f;
+
+	return 1.f - FMath::Clamp(Distance / ThreatRadius, 0.f, 1.f);
+}
+
+float USDTThreatMapSubsystem::GetThreat(const FVector& Location) const
+{
+	return GetThreatAtCell(m_Grid.GetIndex(Location));
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTNavGrid.h"
+#include "SDTThreatMapSubsystem.generated.h"
+
+class ANavigationData;
+class ASDTFleeLocation;
+
+/**
+ * Carte d'influence de la menace du joueur quand il est PoweredUp.
+ * La menace est propagée sur FSDTNavGrid (distance de chemin, pas euclidienne) dans un rayon borné,
+ * et seulement quand le joueur change de cellule: seules les cellules de l'ancien et du nouveau
+ * rayon sont touchées. La menace de chaque FleeLocation est mise en cache après chaque mise à jour,
+ * le choix de fuite par agent ne fait donc plus que des lectures.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTThreatMapSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterFleeLocation(ASDTFleeLocation* FleeLocation);
+	void UnregisterFleeLocation(ASDTFleeLocation* FleeLocation);
+
+	// Vrai si la carte reflète une menace active (joueur PoweredUp)
+	bool IsThreatActive() const { return m_ThreatCellIndex != INDEX_NONE; }
+
+	// Menace normalisée [0, 1] à la position (0 hors du rayon de menace)
+	float GetThreat(const FVector& Location) const;
+
+	/**
+	 * Parcourt les FleeLocations atteignables avec leur menace en cache.
+	 * Visitor(const FVector& Location, float Threat)
+	 */
+	template <typename VisitorType>
+	void ForEachFleeLocation(VisitorType&& Visitor) const
+	{
+		for (const FFleeLocationEntry& Entry : m_FleeLocations)
+		{
+			if (Entry.bWalkable)
+			{
+				Visitor(Entry.Location, Entry.Threat);
+			}
+		}
+	}
+
+	void RebuildGrid();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	UPROPERTY(Config)
+	float CellSize = 150.f;
+
+	// Distance de chemin à partir de laquelle la menace est nulle
+	UPROPERTY(Config)
+	float ThreatRadius = 2500.f;
+
+private:
+	struct FFleeLocationEntry
+	{
+		TWeakObjectPtr<ASDTFleeLocation> Actor;
+		FVector Location;
+		int32 CellIndex;
+		bool bWalkable;
+		float Threat;
+	};
+
+	void UpdateThreat(int32 PlayerCellIndex);
+	void ClearThreat();
+	void RefreshFleeLocationThreats();
+	float GetThreatAtCell(int32 CellIndex) const;
+
+	FSDTNavGrid m_Grid;
+	// Distance de chemin depuis le joueur, FLT_MAX hors du rayon
+	TArray<float> m_ThreatDistances;
+	TArray<int32> m_TouchedCells;
+	int32 m_ThreatCellIndex = INDEX_NONE;
+
+	TArray<FFleeLocationEntry> m_FleeLocations;
+};
@@ -18,7 +18,9 @@ public:
     enum NavType
     {
         Default,
-        Jump
+        Jump,
+        // Point de passage abstrait (portail hiérarchique) encore à raffiner en chemin détaillé
+        HierarchicalPortal
     };
 
     static bool IsNavTypeFlagSet(uint16 flags, NavType type) { return (flags & (1 << type)) != 0; }
@@ -26,4 +28,12 @@ public:
 
     static bool IsNavLink(const FNavPathPoint& PathVert) { return (FNavMeshNodeFlags(PathVert.Flags).PathFlags & RECAST_STRAIGHTPATH_OFFMESH_CONNECTION) != 0; }
     static bool HasJumpFlag(const FNavPathPoint& PathVert) { return     IsNavTypeFlagSet(FNavMeshNodeFlags(PathVert.Flags).AreaFlags, NavType::Jump); }
+    static bool IsHierarchicalPortal(const FNavPathPoint& PathVert) { return IsNavTypeFlagSet(FNavMeshNodeFlags(PathVert.Flags).AreaFlags, NavType::HierarchicalPortal); }
+
+    static FNavPathPoint MakeHierarchicalPortalPoint(const FVector& Location)
+    {
+        FNavMeshNodeFlags flags(0);
+        SetNavTypeFlag(flags.AreaFlags, NavType::HierarchicalPortal);
+        return FNavPathPoint(Location, INVALID_NAVNODEREF, flags.Pack());
+    }
 };
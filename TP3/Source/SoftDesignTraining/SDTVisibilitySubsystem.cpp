@@ -0,0 +1,406 @@
+#include "SDTVisibilitySubsystem.h"
+#include "SoftDesignTraining.h"
+#include "NavigationSystem.h"
+#include "EngineUtils.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr int32 SDTVisibilityBakeVersion = 4;
+
+	FAutoConsoleCommandWithWorld GSDTBakeVisibilityCommand(
+		TEXT("SDT.BakeVisibility"),
+		TEXT("Relance le bake du PVS de LOS sur le navmesh courant."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (USDTVisibilitySubsystem* Visibility = World ? World->GetSubsystem<USDTVisibilitySubsystem>() : nullptr)
+			{
+				Visibility->StartBake();
+			}
+		}));
+}
+
+void USDTVisibilitySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &USDTVisibilitySubsystem::OnNavigationGenerationFinished);
+	}
+
+	if (!LoadBake() && bBakeAfterNavigationBuild)
+	{
+		StartBake();
+	}
+}
+
+void USDTVisibilitySubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &USDTVisibilitySubsystem::OnNavigationGenerationFinished);
+	}
+
+	m_Grid.Reset();
+	m_OccludedBits.Empty();
+	m_VisibleBits.Empty();
+	m_BakeState = EBakeState::None;
+	Super::Deinitialize();
+}
+
+bool USDTVisibilitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USDTVisibilitySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USDTVisibilitySubsystem, STATGROUP_Tickables);
+}
+
+void USDTVisibilitySubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	if (bBakeAfterNavigationBuild)
+	{
+		StartBake();
+	}
+}
+
+void USDTVisibilitySubsystem::StartBake()
+{
+	m_BakeState = EBakeState::None;
+
+	if (!m_Grid.Build(GetWorld(), CellSize))
+		return;
+
+	m_WindowRadius = FMath::CeilToInt(MaxBakeDistance / m_Grid.GetCellSize());
+	m_WindowSize = 2 * m_WindowRadius + 1;
+
+	const int32 NumBits = m_Grid.Num() * m_WindowSize * m_WindowSize;
+	// Rien n'est occulté ni visible tant que le bake ne l'a pas prouvé
+	m_OccludedBits.Init(false, NumBits);
+	m_VisibleBits.Init(false, NumBits);
+	m_bCanProveVisible = !HasMovableOccluders();
+
+	m_BakeCursor = 0;
+	m_BakeState = EBakeState::Baking;
+
+	UE_LOG(LogSoftDesignTraining, Log, TEXT("SDTVisibility: bake de %d cellules (fenêtre %dx%d)"), m_Grid.Num(), m_WindowSize, m_WindowSize);
+}
+
+void USDTVisibilitySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (m_BakeState != EBakeState::Baking)
+		return;
+
+	// Bake étalé sur plusieurs frames
+	const double EndTime = FPlatformTime::Seconds() + BakeBudgetMs / 1000.0;
+	while (m_BakeCursor < m_Grid.Num() && FPlatformTime::Seconds() < EndTime)
+	{
+		BakeCell(m_BakeCursor++);
+	}
+
+	if (m_BakeCursor >= m_Grid.Num())
+	{
+		m_BakeState = EBakeState::Ready;
+		SaveBake();
+
+		UE_LOG(LogSoftDesignTraining, Log, TEXT("SDTVisibility: bake terminé"));
+	}
+}
+
+int32 USDTVisibilitySubsystem::GetBitIndex(int32 CellIndex, const FIntPoint& Offset) const
+{
+	const int32 WindowIndex = (Offset.Y + m_WindowRadius) * m_WindowSize + (Offset.X + m_WindowRadius);
+	return CellIndex * m_WindowSize * m_WindowSize + WindowIndex;
+}
+
+void USDTVisibilitySubsystem::BakeCell(int32 CellIndex)
+{
+	if (!m_Grid.IsWalkable(CellIndex))
+		return;
+
+	const FIntPoint Cell = m_Grid.GetCell(CellIndex);
+	const int32 RadiusSq = m_WindowRadius * m_WindowRadius;
+
+	// Paires symétriques: on ne trace que vers les cellules d'indice supérieur et on écrit les deux sens
+	for (int32 Dy = -m_WindowRadius; Dy <= m_WindowRadius; ++Dy)
+	{
+		for (int32 Dx = -m_WindowRadius; Dx <= m_WindowRadius; ++Dx)
+		{
+			if (Dx * Dx + Dy * Dy > RadiusSq)
+				continue;
+
+			const FIntPoint Offset(Dx, Dy);
+			const int32 OtherIndex = m_Grid.GetIndex(Cell + Offset);
+			if (OtherIndex < CellIndex || !m_Grid.IsWalkable(OtherIndex))
+				continue;
+
+			if (m_bCanProveVisible && IsPairVisible(CellIndex, OtherIndex))
+			{
+				m_VisibleBits[GetBitIndex(CellIndex, Offset)] = true;
+				m_VisibleBits[GetBitIndex(OtherIndex, FIntPoint(-Dx, -Dy))] = true;
+				continue;
+			}
+
+			// Cellules identiques ou voisines: leurs volumes se touchent, aucun mur ne peut les séparer
+			const bool bNeighbours = FMath::Abs(Dx) <= 1 && FMath::Abs(Dy) <= 1;
+			if (bNeighbours || !IsPairOccluded(CellIndex, OtherIndex))
+				continue;
+
+			m_OccludedBits[GetBitIndex(CellIndex, Offset)] = true;
+			m_OccludedBits[GetBitIndex(OtherIndex, FIntPoint(-Dx, -Dy))] = true;
+		}
+	}
+}
+
+void USDTVisibilitySubsystem::GetCellCorners(int32 CellIndex, FVector OutCorners[8]) const
+{
+	// Volume où une requête peut tomber dans la cellule: empreinte XY, hauteur des yeux +- la tolérance
+	const FVector& Ground = m_Grid.GetCellLocation(CellIndex);
+	const FIntPoint Cell = m_Grid.GetCell(CellIndex);
+	const float Size = m_Grid.GetCellSize();
+	const float MinX = m_Grid.GetOrigin().X + Cell.X * Size;
+	const float MinY = m_Grid.GetOrigin().Y + Cell.Y * Size;
+	const float EyeZ = Ground.Z + EyeHeight;
+
+	int32 Count = 0;
+	for (const float Z : { EyeZ - HeightTolerance, EyeZ + HeightTolerance })
+	{
+		OutCorners[Count++] = FVector(MinX, MinY, Z);
+		OutCorners[Count++] = FVector(MinX + Size, MinY, Z);
+		OutCorners[Count++] = FVector(MinX, MinY + Size, Z);
+		OutCorners[Count++] = FVector(MinX + Size, MinY + Size, Z);
+	}
+}
+
+bool USDTVisibilitySubsystem::IsPairOccluded(int32 CellA, int32 CellB) const
+{
+	UWorld* World = GetWorld();
+
+	FVector CornersA[8];
+	FVector CornersB[8];
+	GetCellCorners(CellA, CornersA);
+	GetCellCorners(CellB, CornersB);
+
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SDTVisibilityBake), false);
+
+	// Si un même convexe C coupe les segments coin à coin, il coupe tout segment entre les deux volumes:
+	// l'enveloppe convexe des points d'impact est dans C et chaque segment la traverse.
+	UPrimitiveComponent* Blocker = nullptr;
+	for (int32 i = 0; i < 8; ++i)
+	{
+		for (int32 j = 0; j < 8; ++j)
+		{
+			FHitResult Hit;
+			if (!World->LineTraceSingleByObjectType(Hit, CornersA[i], CornersB[j], ObjectParams, QueryParams))
+				return false;
+
+			UPrimitiveComponent* Comp = Hit.GetComponent();
+			if (!Blocker)
+			{
+				// Géométrie mobile ou collision non réduite à un seul convexe: pas de preuve
+				const UBodySetup* BodySetup = Comp ? Comp->GetBodySetup() : nullptr;
+				if (!BodySetup || Comp->Mobility != EComponentMobility::Static ||
+					BodySetup->CollisionTraceFlag == CTF_UseComplexAsSimple || BodySetup->AggGeom.GetElementCount() != 1)
+					return false;
+
+				Blocker = Comp;
+			}
+			else if (Comp != Blocker)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool USDTVisibilitySubsystem::IsPairVisible(int32 CellA, int32 CellB) const
+{
+	const float Size = m_Grid.GetCellSize();
+	const float HalfDiagonal = Size * 0.5f * UE_SQRT_2;
+	const FVector2D CenterA = FVector2D(m_Grid.GetOrigin()) + (FVector2D(m_Grid.GetCell(CellA)) + 0.5f) * Size;
+	const FVector2D CenterB = FVector2D(m_Grid.GetOrigin()) + (FVector2D(m_Grid.GetCell(CellB)) + 0.5f) * Size;
+	const float EyeA = m_Grid.GetCellLocation(CellA).Z + EyeHeight;
+	const float EyeB = m_Grid.GetCellLocation(CellB).Z + EyeHeight;
+	const float MinZ = FMath::Min(EyeA, EyeB) - HeightTolerance;
+	const float MaxZ = FMath::Max(EyeA, EyeB) + HeightTolerance;
+
+	// Boîte orientée sur A -> B qui contient l'enveloppe des deux volumes (chaque empreinte tient dans
+	// son cercle circonscrit); si rien ne la recoupe, aucun segment entre les volumes n'est bloqué
+	const FVector2D Delta = CenterB - CenterA;
+	const FQuat Rotation = FRotator(0.f, FMath::RadiansToDegrees(FMath::Atan2(Delta.Y, Delta.X)), 0.f).Quaternion();
+	const FVector Extent(Delta.Size() * 0.5f + HalfDiagonal, HalfDiagonal, (MaxZ - MinZ) * 0.5f);
+	const FVector2D Center = (CenterA + CenterB) * 0.5f;
+
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SDTVisibilityBake), false);
+
+	return !GetWorld()->OverlapAnyTestByObjectType(FVector(Center, (MinZ + MaxZ) * 0.5f), Rotation, ObjectParams, FCollisionShape::MakeBox(Extent), QueryParams);
+}
+
+bool USDTVisibilitySubsystem::HasMovableOccluders() const
+{
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		bool bFound = false;
+		It->ForEachComponent<UPrimitiveComponent>(false, [&bFound](const UPrimitiveComponent* Comp)
+		{
+			bFound |= Comp->Mobility != EComponentMobility::Static && Comp->IsCollisionEnabled() &&
+				Comp->GetCollisionObjectType() == ECC_WorldStatic;
+		});
+
+		if (bFound)
+			return true;
+	}
+
+	return false;
+}
+
+ESDTVisibility USDTVisibilitySubsystem::QueryVisibility(const FVector& From, const FVector& To) const
+{
+	if (m_BakeState != EBakeState::Ready)
+		return ESDTVisibility::Unknown;
+
+	const int32 CellA = m_Grid.GetIndex(From);
+	const int32 CellB = m_Grid.GetIndex(To);
+	if (!m_Grid.IsWalkable(CellA) || !m_Grid.IsWalkable(CellB))
+		return ESDTVisibility::Unknown;
+
+	// Point en l'air (saut) ou sur un autre étage que la cellule: pas couvert par le bake
+	if (FMath::Abs(From.Z - (m_Grid.GetCellLocation(CellA).Z + EyeHeight)) > HeightTolerance ||
+		FMath::Abs(To.Z - (m_Grid.GetCellLocation(CellB).Z + EyeHeight)) > HeightTolerance)
+		return ESDTVisibility::Unknown;
+
+	const FIntPoint Offset = m_Grid.GetCell(CellB) - m_Grid.GetCell(CellA);
+	if (FMath::Abs(Offset.X) > m_WindowRadius || FMath::Abs(Offset.Y) > m_WindowRadius)
+		return ESDTVisibility::Unknown;
+
+	const int32 Bit = GetBitIndex(CellA, Offset);
+	if (m_VisibleBits[Bit])
+		return ESDTVisibility::Visible;
+
+	return m_OccludedBits[Bit] ? ESDTVisibility::Occluded : ESDTVisibility::Unknown;
+}
+
+uint32 USDTVisibilitySubsystem::ComputeGeometryHash() const
+{
+	// Somme des empreintes par primitive: indépendante de l'ordre d'itération des acteurs
+	uint32 Hash = 0;
+	int32 NumPrimitives = 0;
+
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		It->ForEachComponent<UPrimitiveComponent>(false, [&Hash, &NumPrimitives](const UPrimitiveComponent* Comp)
+		{
+			if (Comp->Mobility != EComponentMobility::Static || !Comp->IsCollisionEnabled() ||
+				Comp->GetCollisionObjectType() != ECC_WorldStatic)
+				return;
+
+			// Bornes arrondies au centimètre: un mur déplacé, ajouté ou retiré change l'empreinte
+			const FBox Box = Comp->Bounds.GetBox();
+			const FIntVector Min(FMath::RoundToInt(Box.Min.X), FMath::RoundToInt(Box.Min.Y), FMath::RoundToInt(Box.Min.Z));
+			const FIntVector Max(FMath::RoundToInt(Box.Max.X), FMath::RoundToInt(Box.Max.Y), FMath::RoundToInt(Box.Max.Z));
+
+			Hash += HashCombine(GetTypeHash(Min), GetTypeHash(Max));
+			++NumPrimitives;
+		});
+	}
+
+	return HashCombine(Hash, GetTypeHash(NumPrimitives));
+}
+
+FString USDTVisibilitySubsystem::GetBakeFilePath() const
+{
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	return FPaths::ProjectSavedDir() / TEXT("SDTVisibility") / (MapName + TEXT(".bin"));
+}
+
+void USDTVisibilitySubsystem::SaveBake()
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	int32 Version = SDTVisibilityBakeVersion;
+	FIntPoint Dimensions = m_Grid.GetDimensions();
+	FVector Origin = m_Grid.GetOrigin();
+	float BakedCellSize = m_Grid.GetCellSize();
+	float BakedEyeHeight = EyeHeight;
+	int32 WindowRadius = m_WindowRadius;
+	uint32 GeometryHash = ComputeGeometryHash();
+
+	Writer << Version << Dimensions << Origin << BakedCellSize << BakedEyeHeight << WindowRadius << GeometryHash;
+	Writer << m_OccludedBits << m_VisibleBits;
+
+	if (!FFileHelper::SaveArrayToFile(Data, *GetBakeFilePath()))
+	{
+		UE_LOG(LogSoftDesignTraining, Warning, TEXT("SDTVisibility: impossible d'écrire %s"), *GetBakeFilePath());
+	}
+}
+
+bool USDTVisibilitySubsystem::LoadBake()
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetBakeFilePath(), FILEREAD_Silent))
+		return false;
+
+	// Le bake n'est valide que pour la même grille (même navmesh, mêmes réglages) et la même géométrie
+	if (!m_Grid.Build(GetWorld(), CellSize))
+		return false;
+
+	FMemoryReader Reader(Data);
+
+	int32 Version = 0;
+	FIntPoint Dimensions;
+	FVector Origin;
+	float BakedCellSize = 0.f;
+	float BakedEyeHeight = 0.f;
+	int32 WindowRadius = 0;
+	uint32 GeometryHash = 0;
+
+	Reader << Version << Dimensions << Origin << BakedCellSize << BakedEyeHeight << WindowRadius << GeometryHash;
+
+	// Version en premier: un ancien format n'a pas d'empreinte
+	if (Version != SDTVisibilityBakeVersion ||
+		GeometryHash != ComputeGeometryHash() ||
+		Dimensions != m_Grid.GetDimensions() ||
+		!Origin.Equals(m_Grid.GetOrigin(), 1.f) ||
+		!FMath::IsNearlyEqual(BakedCellSize, m_Grid.GetCellSize()) ||
+		!FMath::IsNearlyEqual(BakedEyeHeight, EyeHeight) ||
+		WindowRadius != FMath::CeilToInt(MaxBakeDistance / m_Grid.GetCellSize()))
+	{
+		return false;
+	}
+
+	m_WindowRadius = WindowRadius;
+	m_WindowSize = 2 * m_WindowRadius + 1;
+
+	Reader << m_OccludedBits << m_VisibleBits;
+
+	const int32 NumBits = m_Grid.Num() * m_WindowSize * m_WindowSize;
+	if (Reader.IsError() || m_OccludedBits.Num() != NumBits || m_VisibleBits.Num() != NumBits)
+		return false;
+
+	// Un WorldStatic mobile ajouté depuis le bake peut masquer n'importe quelle paire "visible"
+	if (HasMovableOccluders())
+	{
+		m_VisibleBits.Init(false, NumBits);
+	}
+
+	m_BakeState = EBakeState::Ready;
+	UE_LOG(LogSoftDesignTraining, Log, TEXT("SDTVisibility: bake chargé depuis %s"), *GetBakeFilePath());
+	return true;
+}
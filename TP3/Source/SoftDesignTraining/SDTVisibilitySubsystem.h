@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SDTNavGrid.h"
+#include "SDTVisibilitySubsystem.generated.h"
+
+class ANavigationData;
+
+enum class ESDTVisibility : uint8
+{
+	Visible,
+	Occluded,
+	// Pas de preuve (hors grille, hors fenêtre, paire incertaine, bake en cours): faire un vrai trace
+	Unknown
+};
+
+/**
+ * Ensemble potentiellement visible (PVS) précalculé sur le navmesh.
+ * Pour chaque cellule navigable, on stocke deux bitsets ("visible" et "occulté") sur une fenêtre locale
+ * de cellules (portée de perception). Chaque cellule est un volume: son empreinte XY, à hauteur des yeux
+ * plus ou moins la tolérance de hauteur. Le bake est conservateur dans les deux sens:
+ * - occultée: un même élément convexe de collision statique coupe les 64 segments coin à coin des deux
+ *   volumes, il coupe donc tout segment entre eux (un mur percé ou fait de plusieurs pièces reste Unknown);
+ * - visible: aucune géométrie WorldStatic ne recoupe une boîte englobant l'enveloppe des deux volumes,
+ *   et le niveau n'a aucun WorldStatic mobile qui pourrait y entrer plus tard.
+ * Tout le reste est Unknown et passe par un vrai trace.
+ *
+ * Le bake est lancé après la génération du navmesh (ou via "SDT.BakeVisibility"), étalé sur plusieurs
+ * frames, puis sauvegardé dans Saved/SDTVisibility/<Carte>.bin et rechargé au lancement suivant.
+ * Le fichier porte une empreinte de la géométrie statique du niveau: un bake périmé est ignoré et rebaké.
+ * Les LOS consultent d'abord le bitset et ne retombent sur un trace physique que pour Unknown.
+ */
+UCLASS(config = Game)
+class SOFTDESIGNTRAINING_API USDTVisibilitySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Visibilité entre deux points "tête" (position acteur + hauteur des yeux)
+	ESDTVisibility QueryVisibility(const FVector& From, const FVector& To) const;
+
+	void StartBake();
+	bool IsReady() const { return m_BakeState == EBakeState::Ready; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	UPROPERTY(Config)
+	float CellSize = 200.f;
+
+	// Portée couverte par le bake (au-delà: trace classique). Couvre la capsule de détection des agents.
+	UPROPERTY(Config)
+	float MaxBakeDistance = 2000.f;
+
+	// Hauteur des yeux au-dessus du sol du navmesh (demi-capsule + décalage de tête du service Sense)
+	UPROPERTY(Config)
+	float EyeHeight = 156.f;
+
+	// Écart vertical toléré entre une requête et la hauteur des yeux de sa cellule
+	UPROPERTY(Config)
+	float HeightTolerance = 100.f;
+
+	// Budget du bake par frame
+	UPROPERTY(Config)
+	float BakeBudgetMs = 4.f;
+
+	UPROPERTY(Config)
+	bool bBakeAfterNavigationBuild = true;
+
+private:
+	enum class EBakeState : uint8
+	{
+		None,
+		Baking,
+		Ready
+	};
+
+	void BakeCell(int32 CellIndex);
+	bool IsPairOccluded(int32 CellA, int32 CellB) const;
+	bool IsPairVisible(int32 CellA, int32 CellB) const;
+	void GetCellCorners(int32 CellIndex, FVector OutCorners[8]) const;
+
+	// Vrai si un WorldStatic non statique existe: il pourrait masquer une paire après le bake
+	bool HasMovableOccluders() const;
+	int32 GetBitIndex(int32 CellIndex, const FIntPoint& Offset) const;
+
+	// Empreinte de la géométrie WorldStatic tracée par le bake (bornes des primitives statiques)
+	uint32 ComputeGeometryHash() const;
+
+	FString GetBakeFilePath() const;
+	bool LoadBake();
+	void SaveBake();
+
+	FSDTNavGrid m_Grid;
+	int32 m_WindowRadius = 0;
+	int32 m_WindowSize = 0;
+
+	TBitArray<> m_OccludedBits;
+	TBitArray<> m_VisibleBits;
+	bool m_bCanProveVisible = false;
+
+	EBakeState m_BakeState = EBakeState::None;
+	int32 m_BakeCursor = 0;
+};
@@ -5,6 +5,8 @@
 #include "SoftDesignTrainingMainCharacter.h"
 #include "SDTAIController.h"
 #include "SDTProjectile.h"
+#include "SDTProjectileSubsystem.h"
+#include "SDTContactSubsystem.h"
 #include "SDTUtils.h"
 #include "DrawDebugHelpers.h"
 #include "SDTCollectible.h"
@@ -22,6 +24,32 @@ void ASoftDesignTrainingCharacter::BeginPlay()
 
     GetCapsuleComponent()->OnComponentBeginOverlap.AddDynamic(this, &ASoftDesignTrainingCharacter::OnBeginOverlap);
     m_StartingPosition = GetActorLocation();
+
+    // Les projectiles testent leurs touches contre notre capsule (voir USDTProjectileSubsystem)
+    if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
+    {
+        projectiles->RegisterCharacter(this);
+    }
+
+    if (USDTContactSubsystem* contacts = GetWorld()->GetSubsystem<USDTContactSubsystem>())
+    {
+        contacts->RegisterCharacter(this);
+    }
+}
+
+void ASoftDesignTrainingCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USDTProjectileSubsystem* projectiles = GetWorld()->GetSubsystem<USDTProjectileSubsystem>())
+    {
+        projectiles->UnregisterCharacter(this);
+    }
+
+    if (USDTContactSubsystem* contacts = GetWorld()->GetSubsystem<USDTContactSubsystem>())
+    {
+        contacts->UnregisterCharacter(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ASoftDesignTrainingCharacter::OnBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -41,11 +69,16 @@ void ASoftDesignTrainingCharacter::OnBeginOverlap(UPrimitiveComponent* Overlappe
     }
     else if (ASoftDesignTrainingMainCharacter* mainCharacter = Cast<ASoftDesignTrainingMainCharacter>(OtherActor))
     {
-        if (mainCharacter->IsPoweredUp())
-            Die();
+        OnPlayerContact(mainCharacter);
     }
 }
 
+void ASoftDesignTrainingCharacter::OnPlayerContact(ASoftDesignTrainingMainCharacter* player)
+{
+    if (player->IsPoweredUp())
+        Die();
+}
+
 void ASoftDesignTrainingCharacter::Die()
 {
     SetActorLocation(m_StartingPosition);
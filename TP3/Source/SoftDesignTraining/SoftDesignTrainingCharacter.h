@@ -3,6 +3,8 @@
 #include "GameFramework/Character.h"
 #include "SoftDesignTrainingCharacter.generated.h"
 
+class ASoftDesignTrainingMainCharacter;
+
 
 UCLASS()
 class ASoftDesignTrainingCharacter : public ACharacter
@@ -13,9 +15,13 @@ public:
     ASoftDesignTrainingCharacter();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void OnCollectPowerUp() {};
     void Die();
 
+    // Réponse à l'entrée en contact avec le joueur (USDTContactSubsystem ou overlap)
+    virtual void OnPlayerContact(ASoftDesignTrainingMainCharacter* player);
+
 protected:
     UFUNCTION()
     virtual void OnBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -4,18 +4,50 @@
 #include "SoftDesignTraining.h"
 #include "SoftDesignTrainingPlayerController.h"
 #include "SoftDesignTrainingCharacter.h"
+#include "SDTAIController.h"
+#include "Engine/AssetManager.h"
 
 ASoftDesignTrainingGameMode::ASoftDesignTrainingGameMode()
 {
 	// use our custom PlayerController class
 	PlayerControllerClass = ASoftDesignTrainingPlayerController::StaticClass();
 
-	// set default pawn class to our Blueprinted character
-	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/Blueprint/BP_SDTMainCharacter"));
-	if (PlayerPawnBPClass.Class != NULL)
-	{
-		DefaultPawnClass = PlayerPawnBPClass.Class;
-	}
+	// set default pawn class to our Blueprinted character (loaded asynchronously in InitGame)
+	m_PlayerPawnClass = TSoftClassPtr<APawn>(FSoftObjectPath(TEXT("/Game/Blueprint/BP_SDTMainCharacter.BP_SDTMainCharacter_C")));
+}
+
+void ASoftDesignTrainingGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+    Super::InitGame(MapName, Options, ErrorMessage);
+
+    // Préchargement pendant le chargement de la carte: le premier spawn ne bloque plus sur un chargement synchrone
+    TArray<FSoftObjectPath> assets;
+    assets.Add(m_PlayerPawnClass.ToSoftObjectPath());
+
+    const ASDTAIController* aiDefaults = GetDefault<ASDTAIController>();
+    assets.Add(aiDefaults->BehaviorTreeAsset.ToSoftObjectPath());
+    assets.Add(aiDefaults->BlackboardAsset.ToSoftObjectPath());
+
+    assets.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+    if (assets.Num() > 0)
+    {
+        m_PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(assets, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    }
+}
+
+UClass* ASoftDesignTrainingGameMode::GetDefaultPawnClassForController_Implementation(AController* InController)
+{
+    if (m_PlayerPawnClass.IsNull())
+    {
+        return Super::GetDefaultPawnClassForController_Implementation(InController);
+    }
+
+    // Normalement déjà résident; sinon on termine le chargement ici
+    if (UClass* pawnClass = m_PlayerPawnClass.Get())
+    {
+        return pawnClass;
+    }
+    return m_PlayerPawnClass.LoadSynchronous();
 }
 
 void ASoftDesignTrainingGameMode::StartPlay()
@@ -67,7 +99,10 @@ void ASoftDesignTrainingGameMode::DissolveChaseGroup()
     // Stopper le timer de dissolution "perte de vue totale"
     if (GetWorld())
     {
-        GetWorld()->GetTimerManager().ClearTimer(m_GroupNoLOSTimer);
+        if (USDTCooldownSubsystem* cooldowns = GetWorld()->GetSubsystem<USDTCooldownSubsystem>())
+        {
+            cooldowns->Cancel(m_GroupNoLOSTimer);
+        }
     }
 }
 
@@ -114,13 +149,15 @@ void ASoftDesignTrainingGameMode::UpdateChaseGroupLOS(AActor* Actor, bool bHasLO
         }
     }
 
+    USDTCooldownSubsystem* cooldowns = GetWorld()->GetSubsystem<USDTCooldownSubsystem>();
+
     if (bHasLOS)
     {
         // Au moins un membre a la vue: on annule le timer de dissolution
         m_ChaseGroupHasLOS.Add(Actor);
-        if (GetWorld()->GetTimerManager().IsTimerActive(m_GroupNoLOSTimer))
+        if (cooldowns && cooldowns->IsActive(m_GroupNoLOSTimer))
         {
-            GetWorld()->GetTimerManager().ClearTimer(m_GroupNoLOSTimer);
+            cooldowns->Cancel(m_GroupNoLOSTimer);
         }
     }
     else
@@ -138,14 +175,11 @@ void ASoftDesignTrainingGameMode::UpdateChaseGroupLOS(AActor* Actor, bool bHasLO
         // Si plus aucun membre n'a la LOS, lancer un compte à rebours de dissolution
         if (m_ChaseGroup.Num() > 0 && m_ChaseGroupHasLOS.Num() == 0)
         {
-            if (!GetWorld()->GetTimerManager().IsTimerActive(m_GroupNoLOSTimer))
+            if (cooldowns && !cooldowns->IsActive(m_GroupNoLOSTimer))
             {
-                GetWorld()->GetTimerManager().SetTimer(
-                    m_GroupNoLOSTimer,
-                    this,
-                    &ASoftDesignTrainingGameMode::OnChaseGroupNoLOSTimer,
+                m_GroupNoLOSTimer = cooldowns->Start(
                     m_GroupNoLOSDelay,
-                    false);
+                    FSimpleDelegate::CreateUObject(this, &ASoftDesignTrainingGameMode::OnChaseGroupNoLOSTimer));
             }
         }
     }
@@ -153,6 +187,8 @@ void ASoftDesignTrainingGameMode::UpdateChaseGroupLOS(AActor* Actor, bool bHasLO
 
 void ASoftDesignTrainingGameMode::OnChaseGroupNoLOSTimer()
 {
+    m_GroupNoLOSTimer.Invalidate();
+
     // Recheck: si toujours aucun membre n'a la LOS → dissoudre tout le groupe
     for (auto It = m_ChaseGroupHasLOS.CreateIterator(); It; ++It)
     {
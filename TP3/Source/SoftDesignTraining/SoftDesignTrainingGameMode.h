@@ -1,6 +1,8 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 #pragma once
 #include "GameFramework/GameMode.h"
+#include "Engine/StreamableManager.h"
+#include "SDTCooldownSubsystem.h"
 #include "SoftDesignTrainingGameMode.generated.h"
 
 UCLASS(minimalapi)
@@ -11,7 +13,9 @@ class ASoftDesignTrainingGameMode : public AGameMode
 public:
 	ASoftDesignTrainingGameMode();
 
+    virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
     virtual void StartPlay() override;
+    virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
 
     // Partie 2 - Groupe de poursuite
     // Ajoute un acteur au groupe (aucun retrait individuel - logique "tout ou rien")
@@ -36,6 +40,13 @@ public:
     const TSet<TWeakObjectPtr<AActor>>& GetChaseGroup() const { return m_ChaseGroup; }
 
 private:
+    // Pawn du joueur en référence souple, préchargé dans InitGame avec le BT/BB des agents
+    UPROPERTY(EditDefaultsOnly, Category = Classes)
+    TSoftClassPtr<APawn> m_PlayerPawnClass;
+
+    // Garde les assets préchargés résidents pendant toute la partie
+    TSharedPtr<FStreamableHandle> m_PreloadHandle;
+
     UPROPERTY()
     TSet<TWeakObjectPtr<AActor>> m_ChaseGroup;
 
@@ -48,7 +59,7 @@ private:
     float m_GroupNoLOSDelay = 3.f;
 
     // Timer pour dissoudre quand aucun membre n'a la LOS
-    FTimerHandle m_GroupNoLOSTimer;
+    FSDTCooldownHandle m_GroupNoLOSTimer;
 
     // Verrou temporaire empêchant la ré-adhésion au groupe
     float m_GroupLockUntilTime = 0.f;
@@ -31,15 +31,20 @@ void ASoftDesignTrainingMainCharacter::OnBeginOverlap(UPrimitiveComponent* Overl
 
     if (ASoftDesignTrainingCharacter* character = Cast<ASoftDesignTrainingCharacter>(OtherActor))
     {
-        if (!IsPoweredUp())
+        OnAIContact(character);
+    }
+}
+
+void ASoftDesignTrainingMainCharacter::OnAIContact(ASoftDesignTrainingCharacter* character)
+{
+    if (!IsPoweredUp())
+    {
+        SetActorLocation(m_StartingPosition);
+        if (ASoftDesignTrainingGameMode* gm = Cast<ASoftDesignTrainingGameMode>(GetWorld()->GetAuthGameMode()))
         {
-            SetActorLocation(m_StartingPosition);
-            if (ASoftDesignTrainingGameMode* gm = Cast<ASoftDesignTrainingGameMode>(GetWorld()->GetAuthGameMode()))
-            {
-                // Verrouiller d'abord pour empêcher toute ré-adhésion dans le même tick
-                gm->LockChaseGroup(2.0f);
-                gm->DissolveChaseGroup();
-            }
+            // Verrouiller d'abord pour empêcher toute ré-adhésion dans le même tick
+            gm->LockChaseGroup(2.0f);
+            gm->DissolveChaseGroup();
         }
     }
 }
@@ -55,7 +60,11 @@ void ASoftDesignTrainingMainCharacter::OnCollectPowerUp()
 
     GetMesh()->SetMaterial(0, m_PoweredUpMaterial);
 
-    GetWorld()->GetTimerManager().SetTimer(m_PowerUpTimer, this, &ASoftDesignTrainingMainCharacter::OnPowerUpDone, m_PowerUpDuration, false);
+    if (USDTCooldownSubsystem* cooldowns = GetWorld()->GetSubsystem<USDTCooldownSubsystem>())
+    {
+        cooldowns->Cancel(m_PowerUpTimer);
+        m_PowerUpTimer = cooldowns->Start(m_PowerUpDuration, FSimpleDelegate::CreateUObject(this, &ASoftDesignTrainingMainCharacter::OnPowerUpDone));
+    }
 }
 
 void ASoftDesignTrainingMainCharacter::OnPowerUpDone()
@@ -64,5 +73,5 @@ void ASoftDesignTrainingMainCharacter::OnPowerUpDone()
 
     GetMesh()->SetMaterial(0, nullptr);
 
-    GetWorld()->GetTimerManager().ClearTimer(m_PowerUpTimer);
+    m_PowerUpTimer.Invalidate();
 }
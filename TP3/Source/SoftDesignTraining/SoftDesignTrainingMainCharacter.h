@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "SoftDesignTrainingCharacter.h"
+#include "SDTCooldownSubsystem.h"
 #include "SoftDesignTrainingMainCharacter.generated.h"
 
 /**
@@ -18,6 +19,9 @@ public:
 
     virtual void OnCollectPowerUp() override;
 
+    // Réponse à l'entrée en contact avec une IA (USDTContactSubsystem ou overlap)
+    void OnAIContact(ASoftDesignTrainingCharacter* character);
+
     bool IsPoweredUp() { return m_IsPoweredUp; }
 
 protected:
@@ -38,5 +42,5 @@ protected:
     void OnPowerUpDone();
 
     bool m_IsPoweredUp;
-    FTimerHandle m_PowerUpTimer;
+    FSDTCooldownHandle m_PowerUpTimer;
 };